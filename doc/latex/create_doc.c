@@ -33,6 +33,7 @@ static char * docsin[] = {
     "../../fmpz_vec/doc/fmpz_vec.txt", 
     "../../fmpz_factor/doc/fmpz_factor.txt", 
     "../../fmpz_mat/doc/fmpz_mat.txt", 
+    "../../fmpz_lll/doc/fmpz_lll.txt", 
     "../../fmpz_poly/doc/fmpz_poly.txt", 
     "../../fmpz_poly_factor/doc/fmpz_poly_factor.txt", 
     "../../fmpq/doc/fmpq.txt", 
@@ -51,7 +52,9 @@ static char * docsin[] = {
     "../../long_extras/doc/long_extras.txt",
     "../../doc/longlong.txt",
     "../../mpn_extras/doc/mpn_extras.txt",
+    "../../doc/memory_manager.txt",
     "../../doc/profiler.txt", 
+    "../../doc/thread_pool.txt",
     "../../interfaces/doc/interfaces.txt",
     "../../fft/doc/fft.txt",
     "../../qsieve/doc/qsieve.txt",
@@ -63,6 +66,7 @@ static char * docsout[] = {
     "input/fmpz_vec.tex", 
     "input/fmpz_factor.tex", 
     "input/fmpz_mat.tex",
+    "input/fmpz_lll.tex",
     "input/fmpz_poly.tex", 
     "input/fmpz_poly_factor.tex", 
     "input/fmpq.tex", 
@@ -81,7 +85,9 @@ static char * docsout[] = {
     "input/long_extras.tex",
     "input/longlong.tex", 
     "input/mpn_extras.tex",
+    "input/memory_manager.tex",
     "input/profiler.tex", 
+    "input/thread_pool.tex",
     "input/interfaces.tex",
     "input/fft.tex",
     "input/qsieve.tex",
@@ -117,6 +123,8 @@ static int grp_open = 0;  /* Whether a group section is open    */
 static int fnc_open = 0;  /* Whether a function section is open */
 static int dsc_open = 0;  /* Whether a description is open      */
 
+static int depth = 0;     /* Brackets open in the argument list */
+
 #define FSM
 #define STATE(x)      s_ ## x :
 #define NEXTSTATE(x)  goto s_ ## x
@@ -139,6 +147,29 @@ do {                                                                    \
     }                                                                   \
 } while (0)
 
+/*
+    Returns the index of the bracket closing the argument list among 
+    the first n characters of c, starting from index i with depth 
+    brackets already open inside the argument list, or n if there 
+    is none.  Updates depth accordingly.
+ */
+
+static int closing_bracket(const char *c, int i, int n)
+{
+    for ( ; i < n; i++)
+    {
+        if (c[i] == '(')
+            depth++;
+        else if (c[i] == ')')
+        {
+            if (depth == 0)
+                return i;
+            depth--;
+        }
+    }
+    return n;
+}
+
 /*
     Reads one line from the file into the buffer c (of length at 
     least DOCS_WIDTH + 2).  The number of characters, excluding any 
@@ -412,7 +443,8 @@ static void processfile(void)
         close_function();
 
         for (j = 0; j < n && buf[j] != '('; j++) ;
-        for (k = j; k < n && buf[k] != ')'; k++) ;
+        depth = 0;
+        k = (j < n) ? closing_bracket(buf, j + 1, n) : n;
 
         /* No opening bracket. */
         if (j == n)
@@ -460,7 +492,8 @@ static void processfile(void)
         if (r == DOCS_SUCCESS && n > 0)
         {
             for (j = 0; j < n && buf[j] != '('; j++) ;
-            for (k = j; k < n && buf[k] != ')'; k++) ;
+            depth = 0;
+            k = (j < n) ? closing_bracket(buf, j + 1, n) : n;
             if (j == n)
                 NEXTSTATE(pe);
             strncpy(fnc.name, buf, j);
@@ -487,7 +520,7 @@ static void processfile(void)
         {
             size_t len = strlen(fnc.args);
 
-            for (k = 0; k < n && buf[k] != ')'; k++) ;
+            k = closing_bracket(buf, 0, n);
             strncpy(fnc.args + len, buf, k);
             fnc.args[len + k] = '\0';
             if (k < n)
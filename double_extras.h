@@ -55,6 +55,125 @@ d_polyval(const double * poly, int len, double x)
 
 double d_lambertw(double x);
 
+/* Doubles with exponent *****************************************************/
+
+/*
+   The value m * 2^e, where 0.5 <= |m| < 1, or m = e = 0 for zero. Unlike
+   a double, the range is only limited by the size of a long.
+*/
+typedef struct
+{
+    double m;
+    long e;
+} d_2exp_struct;
+
+typedef d_2exp_struct d_2exp_t[1];
+
+static __inline__ void
+d_2exp_normalise(d_2exp_t x)
+{
+    int k;
+
+    if (x->m == 0.0)
+        x->e = 0;
+    else
+    {
+        x->m = frexp(x->m, &k);
+        x->e += k;
+    }
+}
+
+static __inline__ void
+d_2exp_set_d(d_2exp_t x, double d)
+{
+    x->m = d;
+    x->e = 0;
+    d_2exp_normalise(x);
+}
+
+static __inline__ void
+d_2exp_set(d_2exp_t x, const d_2exp_t y)
+{
+    x->m = y->m;
+    x->e = y->e;
+}
+
+static __inline__ double
+d_2exp_get_d(const d_2exp_t x)
+{
+    if (x->e > DBL_MAX_EXP)
+        return (x->m > 0.0) ? D_INF : -D_INF;
+    if (x->e < DBL_MIN_EXP - D_BITS)
+        return 0.0;
+
+    return ldexp(x->m, (int) x->e);
+}
+
+static __inline__ void
+d_2exp_mul(d_2exp_t z, const d_2exp_t x, const d_2exp_t y)
+{
+    z->m = x->m * y->m;
+    z->e = x->e + y->e;
+    d_2exp_normalise(z);
+}
+
+static __inline__ void
+d_2exp_div(d_2exp_t z, const d_2exp_t x, const d_2exp_t y)
+{
+    z->m = x->m / y->m;
+    z->e = x->e - y->e;
+    d_2exp_normalise(z);
+}
+
+static __inline__ void
+d_2exp_add(d_2exp_t z, const d_2exp_t x, const d_2exp_t y)
+{
+    long d = x->e - y->e;
+
+    if (y->m == 0.0 || (x->m != 0.0 && d > D_BITS + 1))
+        d_2exp_set(z, x);
+    else if (x->m == 0.0 || d < -D_BITS - 1)
+        d_2exp_set(z, y);
+    else if (d >= 0)
+    {
+        z->m = x->m + ldexp(y->m, (int) -d);
+        z->e = x->e;
+        d_2exp_normalise(z);
+    }
+    else
+    {
+        z->m = ldexp(x->m, (int) d) + y->m;
+        z->e = y->e;
+        d_2exp_normalise(z);
+    }
+}
+
+static __inline__ void
+d_2exp_neg(d_2exp_t z, const d_2exp_t x)
+{
+    z->m = -x->m;
+    z->e = x->e;
+}
+
+static __inline__ void
+d_2exp_sub(d_2exp_t z, const d_2exp_t x, const d_2exp_t y)
+{
+    d_2exp_t t;
+
+    d_2exp_neg(t, y);
+    d_2exp_add(z, x, t);
+}
+
+static __inline__ int
+d_2exp_cmp(const d_2exp_t x, const d_2exp_t y)
+{
+    d_2exp_t t;
+
+    d_2exp_sub(t, x, y);
+
+    return (t->m > 0.0) - (t->m < 0.0);
+}
+
 #ifdef __cplusplus
 }
 #endif
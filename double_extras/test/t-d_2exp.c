@@ -0,0 +1,154 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "ulong_extras.h"
+#include "double_extras.h"
+
+static int
+is_normal(const d_2exp_t x)
+{
+    if (x->m == 0.0)
+        return x->e == 0;
+
+    return fabs(x->m) >= 0.5 && fabs(x->m) < 1.0;
+}
+
+int
+main(void)
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("d_2exp....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* agrees with double arithmetic when no overflow can occur */
+    for (iter = 0; iter < 100000 * flint_test_multiplier(); iter++)
+    {
+        double a, b, c;
+        d_2exp_t x, y, z;
+        int cmp, result;
+
+        a = ldexp(d_randtest(state), (int) n_randint(state, 401) - 200);
+        b = ldexp(d_randtest(state), (int) n_randint(state, 401) - 200);
+        if (n_randint(state, 2))
+            a = -a;
+        if (n_randint(state, 2))
+            b = -b;
+        if (n_randint(state, 10) == 0)
+            b = n_randint(state, 2) ? a : -a;
+        if (n_randint(state, 20) == 0)
+            b = 0.0;
+
+        d_2exp_set_d(x, a);
+        d_2exp_set_d(y, b);
+
+        switch (n_randint(state, 4))
+        {
+            case 0:
+                d_2exp_add(z, x, y);
+                c = a + b;
+                break;
+            case 1:
+                d_2exp_sub(z, x, y);
+                c = a - b;
+                break;
+            case 2:
+                d_2exp_mul(z, x, y);
+                c = a * b;
+                break;
+            default:
+                if (b == 0.0)
+                    b = 1.0;
+                d_2exp_set_d(y, b);
+                d_2exp_div(z, x, y);
+                c = a / b;
+        }
+
+        cmp = d_2exp_cmp(x, y);
+
+        result = (is_normal(z) && d_2exp_get_d(z) == c 
+                  && cmp == ((a > b) - (a < b)));
+
+        if (!result)
+        {
+            printf("FAIL:\n");
+            printf("a = %.17g, b = %.17g, c = %.17g\n", a, b, c);
+            printf("z = %.17g * 2^%ld, cmp = %d\n", z->m, z->e, cmp);
+            abort();
+        }
+    }
+
+    /* exponents far outside the range of a double */
+    for (iter = 0; iter < 10000 * flint_test_multiplier(); iter++)
+    {
+        double a, b;
+        long e;
+        d_2exp_t x, y, z, t;
+        int result;
+
+        a = d_randtest(state);
+        b = d_randtest(state);
+        e = n_randint(state, 1000000) + 2000;
+
+        d_2exp_set_d(x, a);
+        d_2exp_set_d(y, b);
+        x->e += e;
+        y->e -= e;
+
+        /* (a 2^e)(b 2^-e) = ab */
+        d_2exp_mul(z, x, y);
+        result = (is_normal(z) && d_2exp_get_d(z) == a * b);
+
+        /* (a 2^e)/(b 2^-e) overflows a double, but not a d_2exp_t */
+        d_2exp_div(t, x, y);
+        result = result && is_normal(t) && t->e >= 2*e - 1
+                        && d_2exp_get_d(t) == D_INF;
+
+        /* a 2^e + b 2^-e = a 2^e */
+        d_2exp_add(t, x, y);
+        result = result && t->m == x->m && t->e == x->e;
+
+        /* b 2^-e underflows to zero */
+        result = result && d_2exp_get_d(y) == 0.0 
+                        && d_2exp_cmp(y, z) < 0 && d_2exp_cmp(x, z) > 0;
+
+        if (!result)
+        {
+            printf("FAIL:\n");
+            printf("a = %.17g, b = %.17g, e = %ld\n", a, b, e);
+            abort();
+        }
+    }
+
+    flint_randclear(state);
+    printf("PASS\n");
+    return 0;
+}
@@ -40,6 +40,7 @@ or implied, of William Hart.
 #undef ulong /* interferes with system includes */
 #include <stdlib.h>
 #include <stdio.h>
+#include <pthread.h>
 #define ulong unsigned long
 
 #include "mpir.h"
@@ -83,6 +84,46 @@ mp_limb_t mpn_sumdiff_n(mp_ptr, mp_ptr, mp_srcptr, mp_srcptr, mp_size_t);
          nn[limbs] = -nn[limbs]; \
    } while (0)
 
+/* 
+   shared state for threaded matrix Fourier passes, each thread taking 
+   the next row or column index from the shared counter i
+*/
+typedef struct
+{
+   mp_size_t n;
+   mp_size_t n1;
+   mp_size_t n2;
+   mp_size_t trunc;
+   mp_size_t trunc2;
+   mp_size_t limbs;
+   mp_bitcnt_t depth;
+   mp_bitcnt_t depth2;
+   mp_bitcnt_t w;
+   mp_limb_t ** ii;
+   mp_limb_t ** jj;
+   mp_limb_t ** t1;
+   mp_limb_t ** t2;
+   mp_limb_t ** temp;
+   mp_limb_t * tt;
+   mp_size_t end;
+   mp_size_t * i;
+   pthread_mutex_t * mutex;
+} fft_mfa_arg_t;
+
+static __inline__
+mp_size_t fft_mfa_next_index(fft_mfa_arg_t * arg)
+{
+   mp_size_t i;
+
+   pthread_mutex_lock(arg->mutex);
+   i = *arg->i;
+   if (i < arg->end)
+      (*arg->i)++;
+   pthread_mutex_unlock(arg->mutex);
+
+   return i;
+}
+
 static __inline__
 void mpn_addmod_2expp1_1(mp_limb_t * r, mp_size_t limbs, mp_limb_signed_t c)
 {
@@ -217,6 +258,10 @@ void ifft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n,
                         mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
                                 mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc);
 
+void fft_mfa_run_parallel(void (* worker)(void *), fft_mfa_arg_t * arg,
+                   mp_limb_t ** t1, mp_limb_t ** t2, mp_limb_t ** temp, 
+                                               mp_limb_t * tt, mp_size_t end);
+
 void fft_negacyclic(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w, 
                              mp_limb_t ** t1, mp_limb_t ** t2, mp_limb_t ** temp);
 
@@ -237,24 +237,18 @@ void fft_mfa_truncate_sqrt2(mp_limb_t ** ii, mp_size_t n,
    }
 }
 
-void fft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, 
-                   mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
-                             mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc)
+static void _fft_outer1_worker(void * arg_ptr)
 {
+   fft_mfa_arg_t * arg = (fft_mfa_arg_t *) arg_ptr;
+   mp_size_t n = arg->n, n1 = arg->n1, n2 = arg->n2;
+   mp_size_t trunc = arg->trunc, limbs = arg->limbs;
+   mp_bitcnt_t depth = arg->depth, w = arg->w;
+   mp_limb_t ** ii = arg->ii;
+   mp_limb_t ** t1 = arg->t1, ** t2 = arg->t2, ** temp = arg->temp;
    mp_size_t i, j;
-   mp_size_t n2 = (2*n)/n1;
-   mp_size_t trunc2 = (trunc - 2*n)/n1;
-   mp_size_t limbs = (n*w)/FLINT_BITS;
-   mp_bitcnt_t depth = 0;
-   mp_bitcnt_t depth2 = 0;
-   
-   while ((1UL<<depth) < n2) depth++;
-   while ((1UL<<depth2) < n1) depth2++;
 
-   /* first half matrix fourier FFT : n2 rows, n1 cols */
-   
    /* FFTs on columns */
-   for (i = 0; i < n1; i++)
+   while ((i = fft_mfa_next_index(arg)) < arg->end)
    {   
       /* relevant part of first layer of full sqrt2 FFT */
       if (w & 1)
@@ -303,12 +297,19 @@ void fft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n,
          if (j < s) SWAP_PTRS(ii[i+j*n1], ii[i+s*n1]);
       }
    }
-      
-   /* second half matrix fourier FFT : n2 rows, n1 cols */
-   ii += 2*n;
+}
+
+static void _fft_outer2_worker(void * arg_ptr)
+{
+   fft_mfa_arg_t * arg = (fft_mfa_arg_t *) arg_ptr;
+   mp_size_t n1 = arg->n1, n2 = arg->n2, trunc2 = arg->trunc2;
+   mp_bitcnt_t depth = arg->depth, w = arg->w;
+   mp_limb_t ** ii = arg->ii;
+   mp_limb_t ** t1 = arg->t1, ** t2 = arg->t2;
+   mp_size_t i, j;
 
    /* FFTs on columns */
-   for (i = 0; i < n1; i++)
+   while ((i = fft_mfa_next_index(arg)) < arg->end)
    {   
       /*
          FFT of length n2 on column i, applying z^{r*i} for rows going up in steps 
@@ -323,3 +324,35 @@ void fft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n,
       }
    }
 }
+
+void fft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, 
+                   mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
+                             mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc)
+{
+   fft_mfa_arg_t arg;
+   mp_size_t n2 = (2*n)/n1;
+   mp_bitcnt_t depth = 0;
+   mp_bitcnt_t depth2 = 0;
+   
+   while ((1UL<<depth) < n2) depth++;
+   while ((1UL<<depth2) < n1) depth2++;
+
+   arg.n = n;
+   arg.n1 = n1;
+   arg.n2 = n2;
+   arg.trunc = trunc;
+   arg.trunc2 = (trunc - 2*n)/n1;
+   arg.limbs = (n*w)/FLINT_BITS;
+   arg.depth = depth;
+   arg.depth2 = depth2;
+   arg.w = w;
+   arg.ii = ii;
+   arg.jj = NULL;
+
+   /* first half matrix fourier FFT : n2 rows, n1 cols */
+   fft_mfa_run_parallel(_fft_outer1_worker, &arg, t1, t2, temp, NULL, n1);
+      
+   /* second half matrix fourier FFT : n2 rows, n1 cols */
+   arg.ii = ii + 2*n;
+   fft_mfa_run_parallel(_fft_outer2_worker, &arg, t1, t2, temp, NULL, n1);
+}
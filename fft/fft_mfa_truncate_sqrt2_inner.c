@@ -33,25 +33,18 @@ or implied, of William Hart.
 #include "ulong_extras.h"
 #include "fft.h"
 
-void fft_mfa_truncate_sqrt2_inner(mp_limb_t ** ii, mp_limb_t ** jj, mp_size_t n, 
-                   mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
-                  mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc, mp_limb_t * tt)
+static void _fft_inner1_worker(void * arg_ptr)
 {
+   fft_mfa_arg_t * arg = (fft_mfa_arg_t *) arg_ptr;
+   mp_size_t n = arg->n, n1 = arg->n1, n2 = arg->n2, limbs = arg->limbs;
+   mp_bitcnt_t depth = arg->depth, w = arg->w;
+   mp_limb_t ** ii = arg->ii, ** jj = arg->jj;
+   mp_limb_t ** t1 = arg->t1, ** t2 = arg->t2;
+   mp_limb_t * tt = arg->tt;
    mp_size_t i, j, s;
-   mp_size_t n2 = (2*n)/n1;
-   mp_size_t trunc2 = (trunc - 2*n)/n1;
-   mp_size_t limbs = (n*w)/FLINT_BITS;
-   mp_bitcnt_t depth = 0;
-   mp_bitcnt_t depth2 = 0;
-   
-   while ((1UL<<depth) < n2) depth++;
-   while ((1UL<<depth2) < n1) depth2++;
-
-   ii += 2*n;
-   jj += 2*n;
 
    /* convolutions on relevant rows */
-   for (s = 0; s < trunc2; s++)
+   while ((s = fft_mfa_next_index(arg)) < arg->end)
    {
       i = n_revbin(s, depth);
       fft_radix2(ii + i*n1, n1/2, w*n2, t1, t2);
@@ -67,12 +60,20 @@ void fft_mfa_truncate_sqrt2_inner(mp_limb_t ** ii, mp_limb_t ** jj, mp_size_t n,
       
       ifft_radix2(ii + i*n1, n1/2, w*n2, t1, t2);
    }
+}
 
-   ii -= 2*n;
-   jj -= 2*n;
+static void _fft_inner2_worker(void * arg_ptr)
+{
+   fft_mfa_arg_t * arg = (fft_mfa_arg_t *) arg_ptr;
+   mp_size_t n = arg->n, n1 = arg->n1, n2 = arg->n2, limbs = arg->limbs;
+   mp_bitcnt_t w = arg->w;
+   mp_limb_t ** ii = arg->ii, ** jj = arg->jj;
+   mp_limb_t ** t1 = arg->t1, ** t2 = arg->t2;
+   mp_limb_t * tt = arg->tt;
+   mp_size_t i, j;
 
    /* convolutions on rows */
-   for (i = 0; i < n2; i++)
+   while ((i = fft_mfa_next_index(arg)) < arg->end)
    {
       fft_radix2(ii + i*n1, n1/2, w*n2, t1, t2);
       if (ii != jj) fft_radix2(jj + i*n1, n1/2, w*n2, t1, t2);
@@ -89,3 +90,35 @@ void fft_mfa_truncate_sqrt2_inner(mp_limb_t ** ii, mp_limb_t ** jj, mp_size_t n,
    }
 }
 
+void fft_mfa_truncate_sqrt2_inner(mp_limb_t ** ii, mp_limb_t ** jj, mp_size_t n, 
+                   mp_bitcnt_t w, mp_limb_t ** t1, mp_limb_t ** t2, 
+                  mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc, mp_limb_t * tt)
+{
+   fft_mfa_arg_t arg;
+   mp_size_t n2 = (2*n)/n1;
+   mp_size_t trunc2 = (trunc - 2*n)/n1;
+   mp_bitcnt_t depth = 0;
+   mp_bitcnt_t depth2 = 0;
+   
+   while ((1UL<<depth) < n2) depth++;
+   while ((1UL<<depth2) < n1) depth2++;
+
+   arg.n = n;
+   arg.n1 = n1;
+   arg.n2 = n2;
+   arg.trunc = trunc;
+   arg.trunc2 = trunc2;
+   arg.limbs = (n*w)/FLINT_BITS;
+   arg.depth = depth;
+   arg.depth2 = depth2;
+   arg.w = w;
+   arg.ii = ii + 2*n;
+   arg.jj = jj + 2*n;
+
+   fft_mfa_run_parallel(_fft_inner1_worker, &arg, t1, t2, temp, tt, trunc2);
+
+   arg.ii = ii;
+   arg.jj = jj;
+
+   fft_mfa_run_parallel(_fft_inner2_worker, &arg, t1, t2, temp, tt, n2);
+}
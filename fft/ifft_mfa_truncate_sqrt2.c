@@ -264,23 +264,17 @@ void ifft_mfa_truncate_sqrt2(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w,
    }
 }
 
-void ifft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w, 
-   mp_limb_t ** t1, mp_limb_t ** t2, mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc)
+static void _ifft_outer1_worker(void * arg_ptr)
 {
+   fft_mfa_arg_t * arg = (fft_mfa_arg_t *) arg_ptr;
+   mp_size_t n1 = arg->n1, n2 = arg->n2;
+   mp_bitcnt_t depth = arg->depth, w = arg->w;
+   mp_limb_t ** ii = arg->ii;
+   mp_limb_t ** t1 = arg->t1, ** t2 = arg->t2;
    mp_size_t i, j;
-   mp_size_t n2 = (2*n)/n1;
-   mp_size_t trunc2 = (trunc - 2*n)/n1;
-   mp_bitcnt_t depth = 0;
-   mp_bitcnt_t depth2 = 0;
-   mp_bitcnt_t limbs = (w*n)/FLINT_BITS;
-   
-   while ((1UL<<depth) < n2) depth++;
-   while ((1UL<<depth2) < n1) depth2++;
 
-   /* first half mfa IFFT : n2 rows, n1 cols */
-   
    /* column IFFTs */
-   for (i = 0; i < n1; i++)
+   while ((i = fft_mfa_next_index(arg)) < arg->end)
    {   
       for (j = 0; j < n2; j++)
       {
@@ -294,12 +288,20 @@ void ifft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w,
       */
       ifft_radix2_twiddle(ii + i, n1, n2/2, w*n1, t1, t2, w, 0, i, 1);
    }
-   
-   /* second half IFFT : n2 rows, n1 cols */
-   ii += 2*n;
+}
+
+static void _ifft_outer2_worker(void * arg_ptr)
+{
+   fft_mfa_arg_t * arg = (fft_mfa_arg_t *) arg_ptr;
+   mp_size_t n = arg->n, n1 = arg->n1, n2 = arg->n2;
+   mp_size_t trunc = arg->trunc, trunc2 = arg->trunc2, limbs = arg->limbs;
+   mp_bitcnt_t depth = arg->depth, depth2 = arg->depth2, w = arg->w;
+   mp_limb_t ** ii = arg->ii;
+   mp_limb_t ** t1 = arg->t1, ** t2 = arg->t2, ** temp = arg->temp;
+   mp_size_t i, j;
 
    /* column IFFTs with relevant sqrt2 layer butterflies combined */
-   for (i = 0; i < n1; i++)
+   while ((i = fft_mfa_next_index(arg)) < arg->end)
    {   
       for (j = 0; j < trunc2; j++)
       {
@@ -368,3 +370,34 @@ void ifft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w,
       }
    }
 }
+
+void ifft_mfa_truncate_sqrt2_outer(mp_limb_t ** ii, mp_size_t n, mp_bitcnt_t w, 
+   mp_limb_t ** t1, mp_limb_t ** t2, mp_limb_t ** temp, mp_size_t n1, mp_size_t trunc)
+{
+   fft_mfa_arg_t arg;
+   mp_size_t n2 = (2*n)/n1;
+   mp_bitcnt_t depth = 0;
+   mp_bitcnt_t depth2 = 0;
+   
+   while ((1UL<<depth) < n2) depth++;
+   while ((1UL<<depth2) < n1) depth2++;
+
+   arg.n = n;
+   arg.n1 = n1;
+   arg.n2 = n2;
+   arg.trunc = trunc;
+   arg.trunc2 = (trunc - 2*n)/n1;
+   arg.limbs = (w*n)/FLINT_BITS;
+   arg.depth = depth;
+   arg.depth2 = depth2;
+   arg.w = w;
+   arg.ii = ii;
+   arg.jj = NULL;
+
+   /* first half mfa IFFT : n2 rows, n1 cols */
+   fft_mfa_run_parallel(_ifft_outer1_worker, &arg, t1, t2, temp, NULL, n1);
+   
+   /* second half IFFT : n2 rows, n1 cols */
+   arg.ii = ii + 2*n;
+   fft_mfa_run_parallel(_ifft_outer2_worker, &arg, t1, t2, temp, NULL, n1);
+}
@@ -0,0 +1,90 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#undef ulong /* interferes with system includes */
+#include <stdlib.h>
+#include <pthread.h>
+#define ulong unsigned long
+#include "mpir.h"
+#include "flint.h"
+#include "fft.h"
+#include "thread_pool.h"
+
+void fft_mfa_run_parallel(void (* worker)(void *), fft_mfa_arg_t * arg,
+                   mp_limb_t ** t1, mp_limb_t ** t2, mp_limb_t ** temp, 
+                                                mp_limb_t * tt, mp_size_t end)
+{
+   mp_size_t i, counter = 0;
+   mp_size_t size = arg->limbs + 1;
+   thread_pool_handle * threads;
+   long num_workers;
+   pthread_mutex_t mutex;
+   fft_mfa_arg_t * args;
+
+   pthread_mutex_init(&mutex, NULL);
+
+   arg->end = end;
+   arg->i = &counter;
+   arg->mutex = &mutex;
+
+   num_workers = flint_request_threads(&threads, end);
+
+   if (num_workers == 0)
+   {
+      arg->t1 = t1;
+      arg->t2 = t2;
+      arg->temp = temp;
+      arg->tt = tt;
+
+      worker(arg);
+   } else
+   {
+      args = flint_malloc(sizeof(fft_mfa_arg_t)*(num_workers + 1));
+
+      /* thread i gets the i-th set of temporaries */
+      for (i = 0; i <= num_workers; i++)
+      {
+         args[i] = *arg;
+         args[i].t1 = t1 + i;
+         args[i].t2 = t2 + i;
+         args[i].temp = temp + i;
+         args[i].tt = tt == NULL ? NULL : tt + 2*i*size;
+      }
+
+      for (i = 0; i < num_workers; i++)
+         thread_pool_wake(global_thread_pool, threads[i], worker, &args[i + 1]);
+
+      worker(&args[0]);
+
+      for (i = 0; i < num_workers; i++)
+         thread_pool_wait(global_thread_pool, threads[i]);
+
+      flint_give_back_threads(threads, num_workers);
+
+      flint_free(args);
+   }
+
+   pthread_mutex_destroy(&mutex);
+}
@@ -48,19 +48,28 @@ void mul_mfa_truncate_sqrt2(mp_limb_t * r1, mp_limb_t * i1, mp_size_t n1,
    mp_size_t j2 = (n2*FLINT_BITS - 1)/bits1 + 1;
    
    mp_size_t i, j, trunc;
+   mp_size_t num_threads = flint_get_num_threads();
 
-   mp_limb_t ** ii, ** jj, * t1, * t2, * s1, * ptr;
+   mp_limb_t ** ii, ** jj, ** t1, ** t2, ** s1, * ptr;
    mp_limb_t * tt;
    
-   ii = flint_malloc((4*(n + n*size) + 5*size)*sizeof(mp_limb_t));
+   ii = flint_malloc(4*(n + n*size)*sizeof(mp_limb_t));
    for (i = 0, ptr = (mp_limb_t *) ii + 4*n; i < 4*n; i++, ptr += size) 
    {
       ii[i] = ptr;
    }
-   t1 = ptr;
-   t2 = t1 + size;
-   s1 = t2 + size;
-   tt = s1 + size;
+
+   /* each thread needs its own temporaries */
+   t1 = flint_malloc(num_threads*(3 + 5*size)*sizeof(mp_limb_t));
+   t2 = t1 + num_threads;
+   s1 = t2 + num_threads;
+   for (i = 0, ptr = (mp_limb_t *) t1 + 3*num_threads; i < num_threads; i++, ptr += 3*size)
+   {
+      t1[i] = ptr;
+      t2[i] = ptr + size;
+      s1[i] = ptr + 2*size;
+   }
+   tt = ptr;
    
    if (i1 != i2)
    {
@@ -79,7 +88,7 @@ void mul_mfa_truncate_sqrt2(mp_limb_t * r1, mp_limb_t * i1, mp_size_t n1,
    for (j = j1 ; j < 4*n; j++)
       flint_mpn_zero(ii[j], limbs + 1);
    
-   fft_mfa_truncate_sqrt2_outer(ii, n, w, &t1, &t2, &s1, sqrt, trunc);
+   fft_mfa_truncate_sqrt2_outer(ii, n, w, t1, t2, s1, sqrt, trunc);
    
    if (i1 != i2)
    {
@@ -87,16 +96,17 @@ void mul_mfa_truncate_sqrt2(mp_limb_t * r1, mp_limb_t * i1, mp_size_t n1,
       for (j = j2 ; j < 4*n; j++)
          flint_mpn_zero(jj[j], limbs + 1);
 
-      fft_mfa_truncate_sqrt2_outer(jj, n, w, &t1, &t2, &s1, sqrt, trunc);
+      fft_mfa_truncate_sqrt2_outer(jj, n, w, t1, t2, s1, sqrt, trunc);
    } else j2 = j1;
    
-   fft_mfa_truncate_sqrt2_inner(ii, jj, n, w, &t1, &t2, &s1, sqrt, trunc, tt);
-   ifft_mfa_truncate_sqrt2_outer(ii, n, w, &t1, &t2, &s1, sqrt, trunc);
+   fft_mfa_truncate_sqrt2_inner(ii, jj, n, w, t1, t2, s1, sqrt, trunc, tt);
+   ifft_mfa_truncate_sqrt2_outer(ii, n, w, t1, t2, s1, sqrt, trunc);
        
    flint_mpn_zero(r1, r_limbs);
    fft_combine_bits(r1, ii, j1 + j2 - 1, bits1, limbs, r_limbs);
      
    flint_free(ii);
+   flint_free(t1);
    if (i1 != i2)
       flint_free(jj);
 }
@@ -53,6 +53,43 @@ void * flint_realloc(void * ptr, size_t size);
 void * flint_calloc(size_t num, size_t size);
 void flint_free(void * ptr);
 
+void flint_set_memory_functions(void * (* alloc_func)(size_t),
+                                void * (* calloc_func)(size_t, size_t),
+                                void * (* realloc_func)(void *, size_t),
+                                void (* free_func)(void *));
+
+void flint_get_memory_functions(void * (** alloc_func)(size_t),
+                                void * (** calloc_func)(size_t, size_t),
+                                void * (** realloc_func)(void *, size_t),
+                                void (** free_func)(void *));
+
+/*
+   Temporary allocation from a per-thread stack. A function using it 
+   declares TMP_INIT with its variables, calls TMP_START before the first 
+   TMP_ALLOC and TMP_END before every return; TMP_END releases everything
+   allocated since the matching TMP_START.
+ */
+typedef struct
+{
+    void * chunk;
+    size_t used;
+} flint_tmp_mark_struct;
+
+typedef flint_tmp_mark_struct flint_tmp_mark_t[1];
+
+void flint_tmp_mark(flint_tmp_mark_t mark);
+void * flint_tmp_alloc(size_t size);
+void flint_tmp_release(flint_tmp_mark_t mark);
+void flint_tmp_cleanup(void);
+
+#define TMP_INIT flint_tmp_mark_t __flint_tmp_mark
+#define TMP_START flint_tmp_mark(__flint_tmp_mark)
+#define TMP_ALLOC(size) flint_tmp_alloc(size)
+#define TMP_END flint_tmp_release(__flint_tmp_mark)
+
+int flint_get_num_threads(void);
+void flint_set_num_threads(int num_threads);
+
 #if __GMP_BITS_PER_MP_LIMB == 64
     #define FLINT_BITS 64
     #define FLINT_D_BITS 53
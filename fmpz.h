@@ -65,6 +65,75 @@ void _fmpz_cleanup_mpz_content(void);
 
 void _fmpz_cleanup(void);
 
+#if FLINT_INLINE_FMPZ
+
+/*
+   The number of limbs stored in the same block as the mpz header when
+   FLINT is configured with --inline-fmpz
+*/
+#ifndef FMPZ_INLINE_LIMBS
+#define FMPZ_INLINE_LIMBS 6
+#endif
+
+typedef struct
+{
+    __mpz_struct mpz[1];
+    mp_ptr heap_d;
+    int heap_alloc;
+    mp_limb_t limbs[FMPZ_INLINE_LIMBS];
+} fmpz_block_struct;
+
+#define _fmpz_mpz_is_inline(z) \
+    ((z)->_mp_d == ((fmpz_block_struct *) (z))->limbs)
+
+__mpz_struct * _fmpz_promote_inline(fmpz_t f);
+
+/* 
+   Sets d and size to the limbs and signed size of c, using t to store 
+   the limb of a small value
+*/
+static __inline__ void
+_fmpz_get_limbs(mp_srcptr * d, long * size, mp_ptr t, fmpz c)
+{
+    if (!COEFF_IS_MPZ(c))
+    {
+        t[0] = FLINT_ABS(c);
+        *d = t;
+        *size = (c > 0) - (c < 0);
+    }
+    else
+    {
+        *d = COEFF_TO_PTR(c)->_mp_d;
+        *size = COEFF_TO_PTR(c)->_mp_size;
+    }
+}
+
+int _fmpz_add_inline(fmpz_t f, fmpz c1, fmpz c2, int negate);
+
+int _fmpz_mul_inline(fmpz_t f, fmpz c1, fmpz c2);
+
+int _fmpz_divexact_inline(fmpz_t f, fmpz c1, fmpz c2);
+
+#endif
+
+typedef struct
+{
+    ulong hits;
+    ulong misses;
+    ulong evictions;
+    ulong num;
+    ulong limbs;
+    ulong bytes;
+} fmpz_cache_stats_struct;
+
+typedef fmpz_cache_stats_struct fmpz_cache_stats_t[1];
+
+void fmpz_cache_trim(void);
+
+void fmpz_cache_set_limits(ulong max_num, ulong max_limbs);
+
+void fmpz_cache_get_stats(fmpz_cache_stats_t stats);
+
 __mpz_struct * _fmpz_promote(fmpz_t f);
 
 __mpz_struct * _fmpz_promote_val(fmpz_t f);
@@ -28,10 +28,105 @@
 #include "ulong_extras.h"
 #include "fmpz.h"
 
+#if FLINT_INLINE_FMPZ
+
+/*
+   Sets f to c1 + c2, or c1 - c2 if negate is set, where at least one of 
+   c1 and c2 is large, in the inline limbs of f. Returns 0 without doing
+   anything if the result might not fit.
+*/
+int _fmpz_add_inline(fmpz_t f, fmpz c1, fmpz c2, int negate)
+{
+    mp_limb_t t1[1], t2[1];
+    mp_srcptr d1, d2;
+    long s1, s2, n1, n2, n;
+    __mpz_struct * z;
+    mp_ptr r;
+    int cmp;
+
+    _fmpz_get_limbs(&d1, &s1, t1, c1);
+    _fmpz_get_limbs(&d2, &s2, t2, c2);
+
+    if (negate)
+        s2 = -s2;
+
+    if (FLINT_ABS(s1) < FLINT_ABS(s2))  /* make d1 the longer operand */
+    {
+        mp_srcptr dt = d1;
+        long st = s1;
+
+        d1 = d2;
+        s1 = s2;
+        d2 = dt;
+        s2 = st;
+    }
+
+    n1 = FLINT_ABS(s1);
+    n2 = FLINT_ABS(s2);
+
+    if (n1 + 1 > FMPZ_INLINE_LIMBS)
+        return 0;
+
+    if (n2 == 0 || (s1 ^ s2) >= 0)  /* magnitudes add */
+    {
+        z = _fmpz_promote_inline(f);
+        r = z->_mp_d;
+
+        if (n2 == 0)
+        {
+            if (r != d1)
+                flint_mpn_copyi(r, d1, n1);
+            n = n1;
+        }
+        else
+        {
+            r[n1] = mpn_add(r, d1, n1, d2, n2);
+            n = n1 + (r[n1] != 0);
+        }
+    }
+    else  /* magnitudes subtract */
+    {
+        cmp = (n1 != n2) ? 1 : mpn_cmp(d1, d2, n1);
+
+        if (cmp == 0)
+        {
+            fmpz_zero(f);
+            return 1;
+        }
+
+        z = _fmpz_promote_inline(f);
+        r = z->_mp_d;
+
+        if (cmp > 0)
+            mpn_sub(r, d1, n1, d2, n2);
+        else
+        {
+            mpn_sub_n(r, d2, d1, n1);
+            s1 = s2;
+        }
+
+        n = n1;
+        while (r[n - 1] == 0)
+            n--;
+    }
+
+    z->_mp_size = (s1 < 0) ? -n : n;
+    _fmpz_demote_val(f);  /* may have cancelled */
+
+    return 1;
+}
+
+#endif
+
 void fmpz_add(fmpz_t f, const fmpz_t g, const fmpz_t h)
 {
     fmpz c1 = *g;
     fmpz c2 = *h;
+
+#if FLINT_INLINE_FMPZ
+    if ((COEFF_IS_MPZ(c1) || COEFF_IS_MPZ(c2)) && _fmpz_add_inline(f, c1, c2, 0))
+        return;
+#endif
     
     if (!COEFF_IS_MPZ(c1))  /* g is small */
     {
@@ -37,7 +37,7 @@ void fmpz_clrbit(fmpz_t f, ulong i)
     }
     else
     {
-        __mpz_struct *ptr = COEFF_TO_PTR(*f);
+        __mpz_struct *ptr = _fmpz_promote_val(f);
 
         mpz_clrbit(ptr, i);
         _fmpz_demote_val(f);
@@ -42,7 +42,7 @@ void fmpz_combit(fmpz_t f, ulong i)
     }
     else
     {
-        __mpz_struct *ptr = COEFF_TO_PTR(*f);
+        __mpz_struct *ptr = _fmpz_promote_val(f);
         mpz_combit(ptr, i);
         _fmpz_demote_val(f);
     }
@@ -30,6 +30,47 @@
 #include "ulong_extras.h"
 #include "fmpz.h"
 
+#if FLINT_INLINE_FMPZ
+
+/*
+   Sets f to c1 / c2, where c1 is large and c2 is nonzero and divides c1,
+   in the inline limbs of f. Returns 0 without doing anything if c1 does 
+   not fit in the inline limbs.
+*/
+int _fmpz_divexact_inline(fmpz_t f, fmpz c1, fmpz c2)
+{
+    mp_limb_t t1[1], t2[1], q[FMPZ_INLINE_LIMBS], r[FMPZ_INLINE_LIMBS];
+    mp_srcptr d1, d2;
+    long s1, s2, n1, n2, n;
+    __mpz_struct * z;
+
+    _fmpz_get_limbs(&d1, &s1, t1, c1);
+    _fmpz_get_limbs(&d2, &s2, t2, c2);
+
+    n1 = FLINT_ABS(s1);
+    n2 = FLINT_ABS(s2);
+
+    if (n1 > FMPZ_INLINE_LIMBS || n1 < n2)
+        return 0;
+
+    if (n2 == 1)
+        mpn_divrem_1(q, 0, d1, n1, d2[0]);
+    else
+        mpn_tdiv_qr(q, r, 0, d1, n1, d2, n2);
+
+    n = n1 - n2 + 1;
+    n -= (q[n - 1] == 0);
+
+    z = _fmpz_promote_inline(f);
+    flint_mpn_copyi(z->_mp_d, q, n);
+    z->_mp_size = ((s1 ^ s2) < 0) ? -n : n;
+    _fmpz_demote_val(f);  /* division by h may result in small value */
+
+    return 1;
+}
+
+#endif
+
 void
 fmpz_divexact(fmpz_t f, const fmpz_t g, const fmpz_t h)
 {
@@ -48,7 +89,14 @@ fmpz_divexact(fmpz_t f, const fmpz_t g, const fmpz_t h)
     }
     else  /* g is large */
     {
-        __mpz_struct * mpz_ptr = _fmpz_promote(f);
+        __mpz_struct * mpz_ptr;
+
+#if FLINT_INLINE_FMPZ
+        if (_fmpz_divexact_inline(f, c1, c2))
+            return;
+#endif
+
+        mpz_ptr = _fmpz_promote(f);
 
         if (!COEFF_IS_MPZ(c2))  /* h is small */
         {
@@ -34,20 +34,234 @@
 /* The number of new mpz's allocated at a time */
 #define MPZ_BLOCK 64 
 
+/* 
+   Default bounds on the number of cached mpz's and on the total number of
+   limbs they hold, per thread
+*/
+#define FMPZ_CACHE_MAX_NUM 65536
+#define FMPZ_CACHE_MAX_LIMBS (1UL << 22)
+
+ulong fmpz_cache_max_num = FMPZ_CACHE_MAX_NUM;
+ulong fmpz_cache_max_limbs = FMPZ_CACHE_MAX_LIMBS;
+
 __thread __mpz_struct ** mpz_free_arr = NULL;
 __thread ulong mpz_free_num = 0;
 __thread ulong mpz_free_alloc = 0;
+__thread ulong mpz_free_limbs = 0;
+
+__thread ulong mpz_cache_hits = 0;
+__thread ulong mpz_cache_misses = 0;
+__thread ulong mpz_cache_evictions = 0;
+
+#if FLINT_INLINE_FMPZ
+
+/*
+   Each mpz lives in an fmpz_block_struct, whose limbs are either the
+   inline ones following the header or, whenever the mpz is handed to
+   MPIR for writing, limbs allocated by MPIR. While the value is inline,
+   any limbs previously allocated by MPIR are kept in heap_d so that
+   switching back and forth does not allocate.
+*/
+
+#define _fmpz_block(z) ((fmpz_block_struct *) (z))
+
+static ulong _fmpz_block_heap_limbs(__mpz_struct * z)
+{
+    return _fmpz_mpz_is_inline(z) ? _fmpz_block(z)->heap_alloc : z->_mp_alloc;
+}
+
+static void _fmpz_block_free_heap(fmpz_block_struct * B)
+{
+    if (B->heap_d != NULL)
+    {
+        __mpz_struct t;
+
+        t._mp_alloc = B->heap_alloc;
+        t._mp_size = 0;
+        t._mp_d = B->heap_d;
+        mpz_clear(&t);
+
+        B->heap_d = NULL;
+        B->heap_alloc = 0;
+    }
+}
+
+static void _fmpz_block_free(__mpz_struct * z)
+{
+    if (_fmpz_mpz_is_inline(z))
+        _fmpz_block_free_heap(_fmpz_block(z));
+    else
+        mpz_clear(z);
+
+    flint_free(z);
+}
+
+/* Move the value of z to limbs allocated by MPIR */
+static void _fmpz_block_detach(__mpz_struct * z)
+{
+    fmpz_block_struct * B = _fmpz_block(z);
+    long n = FLINT_ABS(z->_mp_size);
+
+    if (!_fmpz_mpz_is_inline(z))
+        return;
+
+    if (B->heap_alloc < n)
+        _fmpz_block_free_heap(B);
+
+    if (B->heap_d == NULL)
+    {
+        __mpz_struct t;
+
+        mpz_init2(&t, FLINT_MAX(n, 1)*FLINT_BITS);
+        B->heap_d = t._mp_d;
+        B->heap_alloc = t._mp_alloc;
+    }
+
+    flint_mpn_copyi(B->heap_d, B->limbs, n);
+    z->_mp_d = B->heap_d;
+    z->_mp_alloc = B->heap_alloc;
+    B->heap_d = NULL;
+    B->heap_alloc = 0;
+}
+
+/* Switch z to its inline limbs, without preserving its value */
+static void _fmpz_block_attach(__mpz_struct * z)
+{
+    fmpz_block_struct * B = _fmpz_block(z);
+
+    if (_fmpz_mpz_is_inline(z))
+        return;
+
+    B->heap_d = z->_mp_d;
+    B->heap_alloc = z->_mp_alloc;
+    z->_mp_d = B->limbs;
+    z->_mp_alloc = FMPZ_INLINE_LIMBS;
+}
+
+static __mpz_struct * _fmpz_new_block(void)
+{
+    __mpz_struct * z;
+
+    if (mpz_free_num != 0)
+    {
+        z = mpz_free_arr[--mpz_free_num];
+
+        mpz_free_limbs -= _fmpz_block_heap_limbs(z);
+        mpz_cache_hits++;
+    }
+    else
+    {
+        fmpz_block_struct * B = flint_malloc(sizeof(fmpz_block_struct));
+
+        z = B->mpz;
+        z->_mp_d = B->limbs;
+        z->_mp_alloc = FMPZ_INLINE_LIMBS;
+        B->heap_d = NULL;
+        B->heap_alloc = 0;
+        mpz_cache_misses++;
+    }
+
+    z->_mp_size = 0;
+
+    return z;
+}
+
+__mpz_struct * _fmpz_new_mpz(void)
+{
+    __mpz_struct * z = _fmpz_new_block();
+
+    _fmpz_block_detach(z);
+
+    return z;
+}
+
+__mpz_struct * _fmpz_promote_inline(fmpz_t f)
+{
+    __mpz_struct * z;
+
+    if (!COEFF_IS_MPZ(*f))
+    {
+        z = _fmpz_new_block();
+        *f = PTR_TO_COEFF(z);
+    }
+    else
+        z = COEFF_TO_PTR(*f);
+
+    _fmpz_block_attach(z);
+
+    return z;
+}
+
+void _fmpz_clear_mpz(fmpz f)
+{
+    __mpz_struct * ptr = COEFF_TO_PTR(f);
+    ulong limbs = _fmpz_block_heap_limbs(ptr);
+
+    if (limbs > FLINT_MPZ_MAX_CACHE_LIMBS)
+    {
+        if (_fmpz_mpz_is_inline(ptr))
+            _fmpz_block_free_heap(_fmpz_block(ptr));
+        else
+            mpz_realloc2(ptr, 1);
+
+        limbs = _fmpz_block_heap_limbs(ptr);
+    }
+
+    /* The cache is full, so release this one straight away */
+    if (mpz_free_num >= fmpz_cache_max_num
+        || mpz_free_limbs + limbs > fmpz_cache_max_limbs)
+    {
+        _fmpz_block_free(ptr);
+        mpz_cache_evictions++;
+        return;
+    }
+
+    if (mpz_free_num == mpz_free_alloc)
+    {
+        mpz_free_alloc = FLINT_MAX(64, mpz_free_alloc * 2);
+        mpz_free_arr = flint_realloc(mpz_free_arr, mpz_free_alloc * sizeof(__mpz_struct *));
+    }
+
+    mpz_free_arr[mpz_free_num++] = ptr;
+    mpz_free_limbs += limbs;
+}
+
+void _fmpz_cleanup_mpz_content(void)
+{
+    ulong i;
+
+    for (i = 0; i < mpz_free_num; i++)
+        _fmpz_block_free(mpz_free_arr[i]);
+
+    mpz_free_num = 0;
+    mpz_free_limbs = 0;
+}
+
+#else
+
+#define _fmpz_block_heap_limbs(z) ((ulong) (z)->_mp_alloc)
+
+#define _fmpz_block_free(z) \
+    do { \
+        mpz_clear(z); \
+        flint_free(z); \
+    } while (0)
 
 __mpz_struct * _fmpz_new_mpz(void)
 {
     if (mpz_free_num != 0)
     {
-        return mpz_free_arr[--mpz_free_num];
+        __mpz_struct * z = mpz_free_arr[--mpz_free_num];
+
+        mpz_free_limbs -= z->_mp_alloc;
+        mpz_cache_hits++;
+        return z;
     }
     else
     {
         __mpz_struct * z = flint_malloc(sizeof(__mpz_struct));
         mpz_init(z);
+        mpz_cache_misses++;
         return z;
     }
 }
@@ -59,6 +273,16 @@ void _fmpz_clear_mpz(fmpz f)
     if (ptr->_mp_alloc > FLINT_MPZ_MAX_CACHE_LIMBS)
         mpz_realloc2(ptr, 1);
 
+    /* The cache is full, so release this one straight away */
+    if (mpz_free_num >= fmpz_cache_max_num
+        || mpz_free_limbs + ptr->_mp_alloc > fmpz_cache_max_limbs)
+    {
+        mpz_clear(ptr);
+        flint_free(ptr);
+        mpz_cache_evictions++;
+        return;
+    }
+
     if (mpz_free_num == mpz_free_alloc)
     {
         mpz_free_alloc = FLINT_MAX(64, mpz_free_alloc * 2);
@@ -66,6 +290,7 @@ void _fmpz_clear_mpz(fmpz f)
     }
 
     mpz_free_arr[mpz_free_num++] = ptr;
+    mpz_free_limbs += ptr->_mp_alloc;
 }
 
 void _fmpz_cleanup_mpz_content(void)
@@ -77,12 +302,56 @@ void _fmpz_cleanup_mpz_content(void)
         mpz_clear(mpz_free_arr[i]);
         flint_free(mpz_free_arr[i]);
     }
+
+    mpz_free_num = 0;
+    mpz_free_limbs = 0;
 }
 
+#endif
+
 void _fmpz_cleanup(void)
 {
     _fmpz_cleanup_mpz_content();
     flint_free(mpz_free_arr);
+    mpz_free_arr = NULL;
+    mpz_free_alloc = 0;
+}
+
+void fmpz_cache_trim(void)
+{
+    _fmpz_cleanup();
+}
+
+void fmpz_cache_set_limits(ulong max_num, ulong max_limbs)
+{
+    fmpz_cache_max_num = max_num;
+    fmpz_cache_max_limbs = max_limbs;
+
+    /* Bring the cache of this thread within the new limits */
+    while (mpz_free_num > max_num || mpz_free_limbs > max_limbs)
+    {
+        __mpz_struct * z = mpz_free_arr[--mpz_free_num];
+
+        mpz_free_limbs -= _fmpz_block_heap_limbs(z);
+        _fmpz_block_free(z);
+        mpz_cache_evictions++;
+    }
+}
+
+void fmpz_cache_get_stats(fmpz_cache_stats_t stats)
+{
+    stats->hits = mpz_cache_hits;
+    stats->misses = mpz_cache_misses;
+    stats->evictions = mpz_cache_evictions;
+    stats->num = mpz_free_num;
+    stats->limbs = mpz_free_limbs;
+#if FLINT_INLINE_FMPZ
+    stats->bytes = mpz_free_num * sizeof(fmpz_block_struct)
+#else
+    stats->bytes = mpz_free_num * sizeof(__mpz_struct)
+#endif
+                 + mpz_free_limbs * sizeof(mp_limb_t)
+                 + mpz_free_alloc * sizeof(__mpz_struct *);
 }
 
 __mpz_struct * _fmpz_promote(fmpz_t f)
@@ -94,7 +363,12 @@ __mpz_struct * _fmpz_promote(fmpz_t f)
         return mpz_ptr;
     }
     else /* f is large already, just return the pointer */
+    {
+#if FLINT_INLINE_FMPZ
+        _fmpz_block_detach(COEFF_TO_PTR(*f));
+#endif
         return COEFF_TO_PTR(*f);
+    }
 }
 
 __mpz_struct * _fmpz_promote_val(fmpz_t f)
@@ -108,7 +382,12 @@ __mpz_struct * _fmpz_promote_val(fmpz_t f)
         return mpz_ptr;
     }
     else /* f is large already, just return the pointer */
+    {
+#if FLINT_INLINE_FMPZ
+        _fmpz_block_detach(COEFF_TO_PTR(c));
+#endif
         return COEFF_TO_PTR(c);
+    }
 }
 
 void _fmpz_demote_val(fmpz_t f)
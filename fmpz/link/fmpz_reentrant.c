@@ -49,6 +49,24 @@ void _fmpz_cleanup(void)
 {
 }
 
+void fmpz_cache_trim(void)
+{
+}
+
+void fmpz_cache_set_limits(ulong max_num, ulong max_limbs)
+{
+}
+
+void fmpz_cache_get_stats(fmpz_cache_stats_t stats)
+{
+    stats->hits = 0;
+    stats->misses = 0;
+    stats->evictions = 0;
+    stats->num = 0;
+    stats->limbs = 0;
+    stats->bytes = 0;
+}
+
 __mpz_struct * _fmpz_promote(fmpz_t f)
 {
     if (!COEFF_IS_MPZ(*f))  /* f is small so promote it first */
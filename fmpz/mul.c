@@ -28,6 +28,61 @@
 #include "ulong_extras.h"
 #include "fmpz.h"
 
+#if FLINT_INLINE_FMPZ
+
+/*
+   Sets f to c1 * c2, where at least one of c1 and c2 is large, in the 
+   inline limbs of f. Returns 0 without doing anything if the result might 
+   not fit.
+*/
+int _fmpz_mul_inline(fmpz_t f, fmpz c1, fmpz c2)
+{
+    mp_limb_t t1[1], t2[1], t[FMPZ_INLINE_LIMBS];
+    mp_srcptr d1, d2;
+    long s1, s2, n1, n2, n;
+    __mpz_struct * z;
+    mp_ptr r;
+    int aliased;
+
+    _fmpz_get_limbs(&d1, &s1, t1, c1);
+    _fmpz_get_limbs(&d2, &s2, t2, c2);
+
+    n1 = FLINT_ABS(s1);
+    n2 = FLINT_ABS(s2);
+    n = n1 + n2;
+
+    if (n1 == 0 || n2 == 0)
+    {
+        fmpz_zero(f);
+        return 1;
+    }
+
+    if (n > FMPZ_INLINE_LIMBS)
+        return 0;
+
+    /* mpn_mul does not allow the output to overlap the inputs */
+    aliased = (*f == c1 || *f == c2);
+
+    z = _fmpz_promote_inline(f);
+    r = aliased ? t : z->_mp_d;
+
+    if (n1 >= n2)
+        mpn_mul(r, d1, n1, d2, n2);
+    else
+        mpn_mul(r, d2, n2, d1, n1);
+
+    n -= (r[n - 1] == 0);
+
+    if (aliased)
+        flint_mpn_copyi(z->_mp_d, t, n);
+
+    z->_mp_size = ((s1 ^ s2) < 0) ? -n : n;
+
+    return 1;
+}
+
+#endif
+
 void
 fmpz_mul(fmpz_t f, const fmpz_t g, const fmpz_t h)
 {
@@ -36,6 +91,11 @@ fmpz_mul(fmpz_t f, const fmpz_t g, const fmpz_t h)
 
     c1 = *g;
 
+#if FLINT_INLINE_FMPZ
+    if ((COEFF_IS_MPZ(c1) || COEFF_IS_MPZ(*h)) && _fmpz_mul_inline(f, c1, *h))
+        return;
+#endif
+
     if (!COEFF_IS_MPZ(c1))      /* g is small */
     {
         fmpz_mul_si(f, h, c1);
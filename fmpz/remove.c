@@ -60,7 +60,7 @@ long _fmpz_remove(fmpz_t x, const fmpz_t f, double finv)
     }
     else  /* x is large */
     {
-        __mpz_struct *z = COEFF_TO_PTR(y);
+        __mpz_struct *z = _fmpz_promote_val(x);
 
         if (!COEFF_IS_MPZ(q))  /* f is small */
         {
@@ -43,7 +43,7 @@ void fmpz_setbit(fmpz_t f, ulong i)
     }
     else
     {
-        __mpz_struct *ptr = COEFF_TO_PTR(*f);
+        __mpz_struct *ptr = _fmpz_promote_val(f);
 
         mpz_setbit(ptr, i);
 
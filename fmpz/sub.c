@@ -34,6 +34,11 @@ fmpz_sub(fmpz_t f, const fmpz_t g, const fmpz_t h)
     fmpz c1 = *g;
     fmpz c2 = *h;
 
+#if FLINT_INLINE_FMPZ
+    if ((COEFF_IS_MPZ(c1) || COEFF_IS_MPZ(c2)) && _fmpz_add_inline(f, c1, c2, 1))
+        return;
+#endif
+
     if (!COEFF_IS_MPZ(c1))      /* g is small */
     {
         if (!COEFF_IS_MPZ(c2))  /* both inputs are small */
@@ -0,0 +1,96 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+int
+main(void)
+{
+    int i;
+    flint_rand_t state;
+    fmpz_cache_stats_t stats;
+
+    printf("cache_trim....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 100 * flint_test_multiplier(); i++)
+    {
+        fmpz * vec;
+        long j, len;
+        ulong max_num, max_limbs, calls;
+
+        max_num = n_randint(state, 200);
+        max_limbs = n_randint(state, 2000);
+        fmpz_cache_set_limits(max_num, max_limbs);
+
+        fmpz_cache_get_stats(stats);
+        calls = stats->hits + stats->misses;
+
+        len = n_randint(state, 500);
+        vec = _fmpz_vec_init(len);
+        for (j = 0; j < len; j++)
+            fmpz_randtest(vec + j, state, n_randint(state, 5000) + 1);
+        _fmpz_vec_clear(vec, len);
+
+        fmpz_cache_get_stats(stats);
+
+        if (stats->num > max_num || stats->limbs > max_limbs
+            || stats->hits + stats->misses < calls)
+        {
+            printf("FAIL:\n");
+            printf("max_num = %lu, max_limbs = %lu\n", max_num, max_limbs);
+            printf("num = %lu, limbs = %lu, hits = %lu, misses = %lu\n",
+                stats->num, stats->limbs, stats->hits, stats->misses);
+            abort();
+        }
+
+        if (n_randint(state, 4) == 0)
+        {
+            fmpz_cache_trim();
+            fmpz_cache_get_stats(stats);
+
+            if (stats->num != 0 || stats->limbs != 0 || stats->bytes != 0)
+            {
+                printf("FAIL:\n");
+                printf("cache not empty after trim\n");
+                printf("num = %lu, limbs = %lu, bytes = %lu\n",
+                    stats->num, stats->limbs, stats->bytes);
+                abort();
+            }
+        }
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
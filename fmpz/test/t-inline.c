@@ -0,0 +1,150 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+
+/*
+   Runs random sequences of operations on a few integers, some of them 
+   aliased, mixing the native add/sub/mul/divexact paths with operations 
+   done by MPIR, and compares against the same sequence done with mpz_t's.
+   This exercises switching values between inline and MPIR limbs when 
+   FLINT is configured with --inline-fmpz.
+*/
+
+#define NUM 4
+
+int
+main(void)
+{
+    int i, j, k;
+    flint_rand_t state;
+
+    printf("inline....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 1000 * flint_test_multiplier(); i++)
+    {
+        fmpz a[NUM];
+        mpz_t b[NUM], t;
+
+        mpz_init(t);
+        for (j = 0; j < NUM; j++)
+        {
+            fmpz_init(a + j);
+            mpz_init(b[j]);
+            fmpz_randtest(a + j, state, 1 + n_randint(state, 400));
+            fmpz_get_mpz(b[j], a + j);
+        }
+
+        for (k = 0; k < 100; k++)
+        {
+            long x = n_randint(state, NUM);
+            long y = n_randint(state, NUM);
+            long z = n_randint(state, NUM);
+            ulong e = n_randint(state, 200);
+
+            switch (n_randint(state, 9))
+            {
+                case 0:
+                    fmpz_add(a + x, a + y, a + z);
+                    mpz_add(b[x], b[y], b[z]);
+                    break;
+                case 1:
+                    fmpz_sub(a + x, a + y, a + z);
+                    mpz_sub(b[x], b[y], b[z]);
+                    break;
+                case 2:
+                    fmpz_mul(a + x, a + y, a + z);
+                    mpz_mul(b[x], b[y], b[z]);
+                    break;
+                case 3:
+                    if (x != z && !fmpz_is_zero(a + z))
+                    {
+                        fmpz_mul(a + x, a + y, a + z);
+                        mpz_mul(b[x], b[y], b[z]);
+                        fmpz_divexact(a + x, a + x, a + z);
+                        mpz_divexact(b[x], b[x], b[z]);
+                    }
+                    break;
+                case 4:
+                    fmpz_addmul(a + x, a + y, a + z);
+                    mpz_addmul(b[x], b[y], b[z]);
+                    break;
+                case 5:
+                    fmpz_mul_2exp(a + x, a + y, e);
+                    mpz_mul_2exp(b[x], b[y], e);
+                    break;
+                case 6:
+                    fmpz_setbit(a + x, e);
+                    mpz_setbit(b[x], e);
+                    break;
+                case 7:
+                    fmpz_neg(a + x, a + y);
+                    mpz_neg(b[x], b[y]);
+                    break;
+                default:
+                    fmpz_fdiv_r_2exp(a + x, a + y, 1 + e);
+                    mpz_fdiv_r_2exp(b[x], b[y], 1 + e);
+                    break;
+            }
+
+            /* keep the values from growing without bound */
+            if (fmpz_bits(a + x) > 1000)
+            {
+                fmpz_fdiv_r_2exp(a + x, a + x, 500);
+                mpz_fdiv_r_2exp(b[x], b[x], 500);
+            }
+
+            fmpz_get_mpz(t, a + x);
+
+            if (mpz_cmp(t, b[x]) != 0)
+            {
+                printf("FAIL:\n");
+                printf("i = %d, k = %d\n", i, k);
+                gmp_printf("t = %Zd\nb = %Zd\n", t, b[x]);
+                abort();
+            }
+        }
+
+        mpz_clear(t);
+        for (j = 0; j < NUM; j++)
+        {
+            fmpz_clear(a + j);
+            mpz_clear(b[j]);
+        }
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
@@ -58,6 +58,8 @@ void _fmpz_factor_fit_length(fmpz_factor_t factor, long len);
 
 void _fmpz_factor_append_ui(fmpz_factor_t factor, mp_limb_t p, ulong exp);
 
+void _fmpz_factor_append(fmpz_factor_t factor, const fmpz_t p, ulong exp);
+
 void _fmpz_factor_set_length(fmpz_factor_t factor, long newlen);
 
 /* Factoring *****************************************************************/
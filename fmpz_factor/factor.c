@@ -30,6 +30,135 @@
 #include "fmpz_factor.h"
 #include "mpn_extras.h"
 #include "ulong_extras.h"
+#include "qsieve.h"
+
+/* 
+   Number of primes to use for trial division before switching to 
+   the p+1 method and the quadratic sieve
+*/
+#define FACTOR_TRIAL_PRIMES 3000
+
+/*
+   Appends the prime factors of the single limb n, each with its
+   exponent multiplied by exp
+*/
+static void
+_fmpz_factor_append_factor_ui(fmpz_factor_t factor, mp_limb_t n, ulong exp)
+{
+    n_factor_t fac;
+    int i;
+
+    n_factor_init(&fac);
+    n_factor(&fac, n, 0);
+
+    for (i = 0; i < fac.num; i++)
+        _fmpz_factor_append_ui(factor, fac.p[i], fac.exp[i]*exp);
+}
+
+/*
+   Appends the prime factors of n^exp, where n > 1 has no prime factors 
+   found by trial division. The factors are appended in no particular 
+   order and the same prime may be appended more than once.
+*/
+static void
+_fmpz_factor_hard(fmpz_factor_t factor, const fmpz_t n, ulong exp)
+{
+    fmpz_t f, g;
+    ulong bits, k, B1, c;
+
+    if (fmpz_abs_fits_ui(n))
+    {
+        _fmpz_factor_append_factor_ui(factor, fmpz_get_ui(n), exp);
+        return;
+    }
+
+    if (fmpz_is_probabprime(n))
+    {
+        _fmpz_factor_append(factor, n, exp);
+        return;
+    }
+
+    fmpz_init(f);
+    fmpz_init(g);
+
+    /* 
+       Perfect powers, the quadratic sieve cannot split these. All prime 
+       factors exceed 2^14, so only exponents up to bits/14 are possible.
+    */
+    bits = fmpz_bits(n);
+    for (k = 2; 14*k <= bits; k = n_nextprime(k, 0))
+    {
+        fmpz_root(f, (fmpz *) n, k);
+        fmpz_pow_ui(g, f, k);
+        if (fmpz_equal(g, n))
+        {
+            _fmpz_factor_hard(factor, f, exp*k);
+            goto cleanup;
+        }
+    }
+
+    /* Cheap attempt with p+1 to pull out factors with smooth p +/- 1 */
+    B1 = (bits < 128) ? 2000 : 10000;
+    if (fmpz_factor_pp1(f, n, B1, 7) && !fmpz_is_one(f) && !fmpz_equal(f, n))
+        goto split;
+
+    if (qsieve_factor(f, n))
+        goto split;
+
+    /* 
+       The quadratic sieve should not fail, but if it does, keep trying 
+       p+1 with increasing bounds, which will eventually succeed
+    */
+    for (c = 3; ; c++)
+    {
+        B1 *= 2;
+        if (fmpz_factor_pp1(f, n, B1, c) && !fmpz_is_one(f) && !fmpz_equal(f, n))
+            break;
+    }
+
+split:
+    fmpz_divexact(g, n, f);
+    _fmpz_factor_hard(factor, f, exp);
+    _fmpz_factor_hard(factor, g, exp);
+
+cleanup:
+    fmpz_clear(f);
+    fmpz_clear(g);
+}
+
+/* 
+   Sorts the entries of factor from start onwards by prime and merges 
+   entries with equal primes
+*/
+static void
+_fmpz_factor_sort_merge(fmpz_factor_t factor, long start)
+{
+    long i, j;
+
+    /* insertion sort, there are only ever a handful of entries */
+    for (i = start + 1; i < factor->num; i++)
+    {
+        for (j = i; j > start && fmpz_cmp(factor->p + j - 1, factor->p + j) > 0; j--)
+        {
+            fmpz_swap(factor->p + j - 1, factor->p + j);
+            fmpz_swap(factor->exp + j - 1, factor->exp + j);
+        }
+    }
+
+    for (i = j = start; i < factor->num; i++)
+    {
+        if (j > start && fmpz_equal(factor->p + j - 1, factor->p + i))
+            fmpz_add(factor->exp + j - 1, factor->exp + j - 1, factor->exp + i);
+        else
+        {
+            fmpz_swap(factor->p + j, factor->p + i);
+            fmpz_swap(factor->exp + j, factor->exp + i);
+            j++;
+        }
+    }
+
+    _fmpz_factor_set_length(factor, j);
+}
 
 void
 fmpz_factor(fmpz_factor_t factor, const fmpz_t n)
@@ -113,15 +242,30 @@ fmpz_factor(fmpz_factor_t factor, const fmpz_t n)
         }
         else
         {
-            /* Insert primality test, perfect power test, other factoring
-               algorithms here... */
+            /* Trial division is not finding factors, move on to 
+               the p+1 method and the quadratic sieve */
+            if (trial_stop >= FACTOR_TRIAL_PRIMES)
+                break;
+
             trial_start = trial_stop;
             trial_stop = trial_start + 1000;
         }
     }
 
+    if (xsize > 1)
+    {
+        fmpz_t y;
+        long start = factor->num;
+
+        x->_mp_size = xsize;
+        fmpz_init(y);
+        fmpz_set_mpz(y, x);
+        _fmpz_factor_hard(factor, y, 1);
+        _fmpz_factor_sort_merge(factor, start);
+        fmpz_clear(y);
+    }
     /* Any single-limb factor left? */
-    if (xd[0] != 1)
+    else if (xd[0] != 1)
         _fmpz_factor_extend_factor_ui(factor, xd[0]);
 
     mpz_clear(x);
@@ -138,6 +138,43 @@ int main(void)
     fmpz_set_mpz(x, y);
     check(x);
 
+    /* Products of large primes, some of them repeated */
+    {
+        flint_rand_t state;
+        ulong k, num, bits, e;
+        mp_limb_t p;
+
+        flint_randinit(state);
+
+        for (i = 0; i < 40; i++)
+        {
+            fmpz_t q;
+
+            fmpz_init(q);
+            fmpz_set_ui(x, 1);
+
+            num = n_randint(state, 3) + 1;
+            for (k = 0; k < num; k++)
+            {
+                e = n_randint(state, 3) + 1;
+                bits = FLINT_MAX(16, 110/(num*e));
+                bits = n_randint(state, bits - 15) + 16;
+                p = n_randprime(state, bits, 0);
+                fmpz_set_ui(q, p);
+                fmpz_pow_ui(q, q, e);
+                fmpz_mul(x, x, q);
+            }
+
+            if (n_randint(state, 2))
+                fmpz_neg(x, x);
+
+            check(x);
+            fmpz_clear(q);
+        }
+
+        flint_randclear(state);
+    }
+
     fmpz_clear(x);
     mpz_clear(y);
 
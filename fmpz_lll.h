@@ -0,0 +1,95 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#ifndef FMPZ_LLL_H
+#define FMPZ_LLL_H
+
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mat.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+typedef struct
+{
+    double delta;
+    double eta;
+} fmpz_lll_struct;
+
+typedef fmpz_lll_struct fmpz_lll_t[1];
+
+/* default reduction parameters as used by fpLLL */
+#define FMPZ_LLL_DEFAULT_DELTA 0.99
+#define FMPZ_LLL_DEFAULT_ETA 0.51
+
+/* 
+   bits of an entry above which the Gram matrix of a basis with up to
+   2^10 columns may leave the range of a double
+*/
+#define FMPZ_LLL_D_MAX_BITS 500
+
+/* Context *******************************************************************/
+
+void fmpz_lll_context_init_default(fmpz_lll_t fl);
+
+void fmpz_lll_context_init(fmpz_lll_t fl, double delta, double eta);
+
+/* Internal row operations ***************************************************/
+
+void _fmpz_lll_gram(fmpz_mat_t G, const fmpz_mat_t B);
+
+void _fmpz_lll_row_submul(fmpz_mat_t B, fmpz_mat_t U, fmpz_mat_t G, 
+                                               long k, long j, const fmpz_t X);
+
+void _fmpz_lll_row_move(fmpz_mat_t B, fmpz_mat_t U, fmpz_mat_t G, 
+                                                             long k, long j);
+
+/* LLL reduction *************************************************************/
+
+long fmpz_lll_d(fmpz_mat_t B, fmpz_mat_t U, 
+                                    const fmpz_t gs_B, const fmpz_lll_t fl);
+
+long fmpz_lll_d_2exp(fmpz_mat_t B, fmpz_mat_t U, 
+                                    const fmpz_t gs_B, const fmpz_lll_t fl);
+
+long fmpz_lll_mpfr(fmpz_mat_t B, fmpz_mat_t U, const fmpz_t gs_B, 
+                                       mp_bitcnt_t prec, const fmpz_lll_t fl);
+
+long fmpz_lll_with_removal(fmpz_mat_t B, fmpz_mat_t U, 
+                                    const fmpz_t gs_B, const fmpz_lll_t fl);
+
+void fmpz_lll(fmpz_mat_t B, fmpz_mat_t U, const fmpz_lll_t fl);
+
+int fmpz_lll_is_reduced(const fmpz_mat_t B, const fmpz_lll_t fl);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
@@ -0,0 +1,44 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#undef ulong /* avoid clash with stdlib */
+#include <stdio.h>
+#include <stdlib.h>
+#define ulong unsigned long 
+
+#include "fmpz_lll.h"
+
+void
+fmpz_lll_context_init(fmpz_lll_t fl, double delta, double eta)
+{
+    if (!(delta > 0.25 && delta < 1.0 && eta >= 0.5 && eta*eta < delta))
+    {
+        printf("Exception (fmpz_lll_context_init). Invalid parameters.\n");
+        abort();
+    }
+
+    fl->delta = delta;
+    fl->eta = eta;
+}
@@ -0,0 +1,228 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#undef ulong /* avoid clash with stdlib */
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#define ulong unsigned long 
+
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mat.h"
+#include "double_extras.h"
+#include "fmpz_lll.h"
+
+/* false for infinities and NaN's */
+#define IS_FINITE(x) (fabs(x) <= DBL_MAX)
+
+/*
+   Lazy size reduction of row kappa of B against rows zeros to kappa - 1,
+   leaving the Gram-Schmidt data for row kappa in r and mu and the squared
+   norms of the projections of b_kappa in s, i.e. s[j] for zeros <= j 
+   <= kappa is the squared norm of b_kappa projected orthogonally to 
+   b_zeros, ..., b_{j-1}. Returns 0 if the precision is not sufficient.
+*/
+static int
+_fmpz_lll_d_babai(fmpz_mat_t B, fmpz_mat_t U, fmpz_mat_t G, double ** r, 
+       double ** mu, double * s, long zeros, long kappa, double halfplus)
+{
+    long i, j;
+    double tmp, max, prev = HUGE_VAL;
+    int stalls = 0, ret = 1;
+    fmpz_t X;
+
+    fmpz_init(X);
+
+    while (1)
+    {
+        max = 0.0;
+
+        for (j = zeros; j < kappa; j++)
+        {
+            tmp = fmpz_get_d(fmpz_mat_entry(G, kappa, j));
+            for (i = zeros; i < j; i++)
+                tmp -= mu[j][i]*r[kappa][i];
+
+            r[kappa][j] = tmp;
+            mu[kappa][j] = tmp/r[j][j];
+
+            if (!IS_FINITE(mu[kappa][j]))
+            {
+                ret = 0;
+                goto cleanup;
+            }
+
+            max = FLINT_MAX(max, fabs(mu[kappa][j]));
+        }
+
+        if (max <= halfplus)
+            break;
+
+        /* 
+           each sweep should shrink the largest |mu|; if two sweeps running 
+           fail to do so, mu is too inaccurate to make progress
+        */
+        if (max < prev)
+        {
+            prev = max;
+            stalls = 0;
+        }
+        else if (++stalls == 2)
+        {
+            ret = 0;
+            goto cleanup;
+        }
+
+        for (j = kappa - 1; j >= zeros; j--)
+        {
+            tmp = floor(mu[kappa][j] + 0.5);
+
+            if (tmp != 0.0)
+            {
+                for (i = zeros; i < j; i++)
+                    mu[kappa][i] -= tmp*mu[j][i];
+
+                fmpz_set_d(X, tmp);
+                _fmpz_lll_row_submul(B, U, G, kappa, j, X);
+            }
+        }
+    }
+
+    s[zeros] = fmpz_get_d(fmpz_mat_entry(G, kappa, kappa));
+    for (j = zeros; j < kappa; j++)
+        s[j + 1] = s[j] - mu[kappa][j]*r[kappa][j];
+
+cleanup:
+
+    fmpz_clear(X);
+
+    return ret;
+}
+
+long
+fmpz_lll_d(fmpz_mat_t B, fmpz_mat_t U, const fmpz_t gs_B, const fmpz_lll_t fl)
+{
+    long d = B->r, i, kappa, kappa2, zeros;
+    double ** r, ** mu, * s, * t, * block;
+    double ctt, halfplus, gsB;
+    fmpz_mat_t G;
+
+    if (d == 0)
+        return 0;
+
+    if (FLINT_ABS(fmpz_mat_max_bits(B)) > FMPZ_LLL_D_MAX_BITS || B->c > 1024)
+        return -1;
+
+    /* 
+       slightly stronger conditions than requested, to allow for the 
+       error in the floating point Gram-Schmidt data
+    */
+    ctt = (fl->delta + 1.0)/2;
+    halfplus = (fl->eta + 0.5)/2;
+
+    if (gs_B == NULL || fmpz_bits(gs_B) > 1000)
+        gsB = D_INF;
+    else
+        gsB = fmpz_get_d(gs_B)*(1.0 + ldexp(1.0, -20));
+
+    fmpz_mat_init(G, d, d);
+    _fmpz_lll_gram(G, B);
+
+    r = flint_malloc(2*d*sizeof(double *));
+    mu = r + d;
+    block = flint_malloc((2*d*d + d + 1)*sizeof(double));
+    for (i = 0; i < 2*d; i++)
+        r[i] = block + i*d;
+    s = block + 2*d*d;
+
+    zeros = 0;
+    kappa = 0;
+
+    while (kappa < d)
+    {
+        if (!_fmpz_lll_d_babai(B, U, G, r, mu, s, zeros, kappa, halfplus))
+        {
+            d = -1;
+            break;
+        }
+
+        /* move zero vectors to the top and start again after them */
+        if (fmpz_is_zero(fmpz_mat_entry(G, kappa, kappa)))
+        {
+            _fmpz_lll_row_move(B, U, G, kappa, zeros);
+            zeros++;
+            kappa = zeros;
+            continue;
+        }
+
+        /* Lovasz condition, find the position to insert b_kappa */
+        kappa2 = kappa;
+        while (kappa > zeros && ctt*r[kappa - 1][kappa - 1] > s[kappa - 1])
+            kappa--;
+
+        /* 
+           early abort: a vector whose projection is longer than gs_B 
+           cannot be involved in any vector of norm at most gs_B; only 
+           trust the projection once b_kappa passes the Lovasz test
+        */
+        if (kappa == kappa2 && kappa == d - 1 && s[kappa] > gsB)
+        {
+            d--;
+            continue;
+        }
+
+        if (kappa != kappa2)
+        {
+            _fmpz_lll_row_move(B, U, G, kappa2, kappa);
+
+            t = r[kappa2];
+            memmove(r + kappa + 1, r + kappa, (kappa2 - kappa)*sizeof(double *));
+            r[kappa] = t;
+
+            t = mu[kappa2];
+            memmove(mu + kappa + 1, mu + kappa, (kappa2 - kappa)*sizeof(double *));
+            mu[kappa] = t;
+        }
+
+        r[kappa][kappa] = s[kappa];
+        kappa++;
+    }
+
+    /* drop any trailing vectors with long projections */
+    if (d != -1)
+    {
+        while (d > zeros && r[d - 1][d - 1] > gsB)
+            d--;
+    }
+
+    flint_free(block);
+    flint_free(r);
+    fmpz_mat_clear(G);
+
+    return d;
+}
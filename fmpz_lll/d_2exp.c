@@ -0,0 +1,259 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#undef ulong /* avoid clash with stdlib */
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#define ulong unsigned long 
+
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mat.h"
+#include "double_extras.h"
+#include "fmpz_lll.h"
+
+static __inline__ void
+_d_2exp_set_fmpz(d_2exp_t x, const fmpz_t f)
+{
+    x->m = fmpz_get_d_2exp(&x->e, f);
+}
+
+/* set X to the integer nearest to x */
+static void
+_fmpz_set_d_2exp_round(fmpz_t X, const d_2exp_t x)
+{
+    if (x->e <= D_BITS)
+        fmpz_set_d(X, floor(ldexp(x->m, (int) x->e) + 0.5));
+    else
+    {
+        fmpz_set_d(X, ldexp(x->m, D_BITS));
+        fmpz_mul_2exp(X, X, x->e - D_BITS);
+    }
+}
+
+/* As for _fmpz_lll_d_babai, but with doubles with exponent */
+static int
+_fmpz_lll_d_2exp_babai(fmpz_mat_t B, fmpz_mat_t U, fmpz_mat_t G, 
+                       d_2exp_struct ** r, d_2exp_struct ** mu, 
+                       d_2exp_struct * s, long zeros, long kappa, 
+                       double halfplus)
+{
+    long i, j;
+    d_2exp_t tmp, X2, max, prev, half;
+    int stalls = -1, ret = 1;
+    fmpz_t X;
+
+    fmpz_init(X);
+    d_2exp_set_d(half, halfplus);
+    d_2exp_set_d(prev, 0.0);
+
+    while (1)
+    {
+        d_2exp_set_d(max, 0.0);
+
+        for (j = zeros; j < kappa; j++)
+        {
+            _d_2exp_set_fmpz(tmp, fmpz_mat_entry(G, kappa, j));
+            for (i = zeros; i < j; i++)
+            {
+                d_2exp_mul(X2, mu[j] + i, r[kappa] + i);
+                d_2exp_sub(tmp, tmp, X2);
+            }
+
+            d_2exp_set(r[kappa] + j, tmp);
+            d_2exp_div(mu[kappa] + j, tmp, r[j] + j);
+
+            if (!(fabs(mu[kappa][j].m) <= 1.0))
+            {
+                ret = 0;
+                goto cleanup;
+            }
+
+            d_2exp_set(tmp, mu[kappa] + j);
+            tmp->m = fabs(tmp->m);
+            if (d_2exp_cmp(tmp, max) > 0)
+                d_2exp_set(max, tmp);
+        }
+
+        if (d_2exp_cmp(max, half) <= 0)
+            break;
+
+        /* 
+           each sweep should shrink the largest |mu|; if two sweeps running 
+           fail to do so, mu is too inaccurate to make progress
+        */
+        if (stalls == -1 || d_2exp_cmp(max, prev) < 0)
+        {
+            d_2exp_set(prev, max);
+            stalls = 0;
+        }
+        else if (++stalls == 2)
+        {
+            ret = 0;
+            goto cleanup;
+        }
+
+        for (j = kappa - 1; j >= zeros; j--)
+        {
+            _fmpz_set_d_2exp_round(X, mu[kappa] + j);
+
+            if (!fmpz_is_zero(X))
+            {
+                _d_2exp_set_fmpz(X2, X);
+                for (i = zeros; i < j; i++)
+                {
+                    d_2exp_mul(tmp, X2, mu[j] + i);
+                    d_2exp_sub(mu[kappa] + i, mu[kappa] + i, tmp);
+                }
+
+                _fmpz_lll_row_submul(B, U, G, kappa, j, X);
+            }
+        }
+    }
+
+    _d_2exp_set_fmpz(s + zeros, fmpz_mat_entry(G, kappa, kappa));
+    for (j = zeros; j < kappa; j++)
+    {
+        d_2exp_mul(tmp, mu[kappa] + j, r[kappa] + j);
+        d_2exp_sub(s + j + 1, s + j, tmp);
+    }
+
+cleanup:
+
+    fmpz_clear(X);
+
+    return ret;
+}
+
+long
+fmpz_lll_d_2exp(fmpz_mat_t B, fmpz_mat_t U, 
+                                     const fmpz_t gs_B, const fmpz_lll_t fl)
+{
+    long d = B->r, i, kappa, kappa2, zeros;
+    d_2exp_struct ** r, ** mu, * s, * t, * block;
+    d_2exp_t ctt, tmp, gsB;
+    double halfplus;
+    int have_gsB;
+    fmpz_mat_t G;
+
+    if (d == 0)
+        return 0;
+
+    /* 
+       slightly stronger conditions than requested, to allow for the 
+       error in the floating point Gram-Schmidt data
+    */
+    d_2exp_set_d(ctt, (fl->delta + 1.0)/2);
+    halfplus = (fl->eta + 0.5)/2;
+
+    have_gsB = (gs_B != NULL);
+    if (have_gsB)
+    {
+        _d_2exp_set_fmpz(gsB, gs_B);
+        gsB->m *= (1.0 + ldexp(1.0, -20));
+        d_2exp_normalise(gsB);
+    }
+
+    fmpz_mat_init(G, d, d);
+    _fmpz_lll_gram(G, B);
+
+    r = flint_malloc(2*d*sizeof(d_2exp_struct *));
+    mu = r + d;
+    block = flint_malloc((2*d*d + d + 1)*sizeof(d_2exp_struct));
+    for (i = 0; i < 2*d; i++)
+        r[i] = block + i*d;
+    s = block + 2*d*d;
+
+    zeros = 0;
+    kappa = 0;
+
+    while (kappa < d)
+    {
+        if (!_fmpz_lll_d_2exp_babai(B, U, G, r, mu, s, zeros, kappa, halfplus))
+        {
+            d = -1;
+            break;
+        }
+
+        /* move zero vectors to the top and start again after them */
+        if (fmpz_is_zero(fmpz_mat_entry(G, kappa, kappa)))
+        {
+            _fmpz_lll_row_move(B, U, G, kappa, zeros);
+            zeros++;
+            kappa = zeros;
+            continue;
+        }
+
+        /* Lovasz condition, find the position to insert b_kappa */
+        kappa2 = kappa;
+        while (kappa > zeros)
+        {
+            d_2exp_mul(tmp, ctt, r[kappa - 1] + kappa - 1);
+            if (d_2exp_cmp(tmp, s + kappa - 1) <= 0)
+                break;
+            kappa--;
+        }
+
+        /* early abort, see fmpz_lll_d */
+        if (have_gsB && kappa == kappa2 && kappa == d - 1 && d_2exp_cmp(s + kappa, gsB) > 0)
+        {
+            d--;
+            continue;
+        }
+
+        if (kappa != kappa2)
+        {
+            _fmpz_lll_row_move(B, U, G, kappa2, kappa);
+
+            t = r[kappa2];
+            memmove(r + kappa + 1, r + kappa, 
+                                      (kappa2 - kappa)*sizeof(d_2exp_struct *));
+            r[kappa] = t;
+
+            t = mu[kappa2];
+            memmove(mu + kappa + 1, mu + kappa, 
+                                      (kappa2 - kappa)*sizeof(d_2exp_struct *));
+            mu[kappa] = t;
+        }
+
+        d_2exp_set(r[kappa] + kappa, s + kappa);
+        kappa++;
+    }
+
+    /* drop any trailing vectors with long projections */
+    if (d != -1 && have_gsB)
+    {
+        while (d > zeros && d_2exp_cmp(r[d - 1] + d - 1, gsB) > 0)
+            d--;
+    }
+
+    flint_free(block);
+    flint_free(r);
+    fmpz_mat_clear(G);
+
+    return d;
+}
@@ -0,0 +1,51 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_mat.h"
+#include "fmpz_lll.h"
+
+void
+_fmpz_lll_gram(fmpz_mat_t G, const fmpz_mat_t B)
+{
+    long i, j, k;
+
+    for (i = 0; i < B->r; i++)
+    {
+        for (j = 0; j <= i; j++)
+        {
+            fmpz * g = fmpz_mat_entry(G, i, j);
+
+            fmpz_zero(g);
+            for (k = 0; k < B->c; k++)
+                fmpz_addmul(g, fmpz_mat_entry(B, i, k), fmpz_mat_entry(B, j, k));
+
+            fmpz_set(fmpz_mat_entry(G, j, i), g);
+        }
+    }
+}
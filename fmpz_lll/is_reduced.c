@@ -0,0 +1,132 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#undef ulong /* avoid clash with stdlib */
+#include <math.h>
+#define ulong unsigned long 
+
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mat.h"
+#include "fmpq.h"
+#include "fmpq_mat.h"
+#include "fmpz_lll.h"
+
+/* x must be in [1/4, 1) so that x*2^60 is an integer */
+static void
+_fmpq_set_d(fmpq_t y, double x)
+{
+    fmpz_t num, den;
+
+    fmpz_init(num);
+    fmpz_init(den);
+
+    fmpz_set_d(num, ldexp(x, 60));
+    fmpz_set_ui(den, 1);
+    fmpz_mul_2exp(den, den, 60);
+    fmpq_set_fmpz_frac(y, num, den);
+
+    fmpz_clear(num);
+    fmpz_clear(den);
+}
+
+int
+fmpz_lll_is_reduced(const fmpz_mat_t B, const fmpz_lll_t fl)
+{
+    long d = B->r, i, j, k, zeros;
+    fmpz_mat_t G;
+    fmpq_mat_t r, mu;
+    fmpq_t delta, eta, t;
+    int ret = 1;
+
+    if (d == 0)
+        return 1;
+
+    fmpz_mat_init(G, d, d);
+    fmpq_mat_init(r, d, d);
+    fmpq_mat_init(mu, d, d);
+    fmpq_init(delta);
+    fmpq_init(eta);
+    fmpq_init(t);
+
+    _fmpz_lll_gram(G, B);
+    _fmpq_set_d(delta, fl->delta);
+    _fmpq_set_d(eta, fl->eta);
+
+    /* zero vectors are only allowed at the top */
+    for (zeros = 0; zeros < d && fmpz_is_zero(fmpz_mat_entry(G, zeros, zeros)); )
+        zeros++;
+
+    for (i = zeros; i < d && ret; i++)
+    {
+        /* exact Gram-Schmidt data for row i */
+        for (j = zeros; j <= i; j++)
+        {
+            fmpq * rij = fmpq_mat_entry(r, i, j);
+
+            fmpz_set(fmpq_numref(rij), fmpz_mat_entry(G, i, j));
+            fmpz_one(fmpq_denref(rij));
+
+            for (k = zeros; k < j; k++)
+                fmpq_submul(rij, fmpq_mat_entry(mu, j, k), fmpq_mat_entry(r, i, k));
+
+            if (j < i)
+            {
+                fmpq_div(fmpq_mat_entry(mu, i, j), rij, fmpq_mat_entry(r, j, j));
+
+                fmpq_abs(t, fmpq_mat_entry(mu, i, j));
+                if (fmpq_cmp(t, eta) > 0)
+                    ret = 0;
+            }
+        }
+
+        /* the nonzero vectors must be linearly independent */
+        if (fmpq_is_zero(fmpq_mat_entry(r, i, i)))
+        {
+            ret = 0;
+            break;
+        }
+
+        /* Lovasz condition (delta - mu^2) r_{i-1} <= r_i */
+        if (i > zeros)
+        {
+            fmpq_mul(t, fmpq_mat_entry(mu, i, i - 1), fmpq_mat_entry(mu, i, i - 1));
+            fmpq_sub(t, delta, t);
+            fmpq_mul(t, t, fmpq_mat_entry(r, i - 1, i - 1));
+            if (fmpq_cmp(t, fmpq_mat_entry(r, i, i)) > 0)
+                ret = 0;
+        }
+    }
+
+    fmpz_mat_clear(G);
+    fmpq_mat_clear(r);
+    fmpq_mat_clear(mu);
+    fmpq_clear(delta);
+    fmpq_clear(eta);
+    fmpq_clear(t);
+
+    return ret;
+}
@@ -0,0 +1,263 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#undef ulong /* avoid clash with stdlib */
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#define ulong unsigned long 
+
+#include <mpir.h>
+#include <mpfr.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mat.h"
+#include "mpfr_vec.h"
+#include "mpfr_mat.h"
+#include "fmpz_lll.h"
+
+static __inline__ void
+_mpfr_set_fmpz(mpfr_t x, const fmpz_t f)
+{
+    if (!COEFF_IS_MPZ(*f))
+        mpfr_set_si(x, *f, GMP_RNDN);
+    else
+        mpfr_set_z(x, COEFF_TO_PTR(*f), GMP_RNDN);
+}
+
+/* As for _fmpz_lll_d_babai, but with mpfr's */
+static int
+_fmpz_lll_mpfr_babai(fmpz_mat_t B, fmpz_mat_t U, fmpz_mat_t G, 
+                     mpfr_mat_t r, mpfr_mat_t mu, __mpfr_struct * s, 
+                     long zeros, long kappa, double halfplus, 
+                     mpfr_t tmp, mpfr_t tmp2)
+{
+    long i, j;
+    int stalls = -1, ret = 1;
+    fmpz_t X;
+    mpz_t Z;
+    mpfr_t max, prev;
+    __mpfr_struct ** R = r->rows, ** M = mu->rows;
+
+    fmpz_init(X);
+    mpz_init(Z);
+    mpfr_init2(max, mpfr_get_prec(tmp));
+    mpfr_init2(prev, mpfr_get_prec(tmp));
+
+    while (1)
+    {
+        mpfr_set_ui(max, 0, GMP_RNDN);
+
+        for (j = zeros; j < kappa; j++)
+        {
+            _mpfr_set_fmpz(R[kappa] + j, fmpz_mat_entry(G, kappa, j));
+            for (i = zeros; i < j; i++)
+            {
+                mpfr_mul(tmp, M[j] + i, R[kappa] + i, GMP_RNDN);
+                mpfr_sub(R[kappa] + j, R[kappa] + j, tmp, GMP_RNDN);
+            }
+
+            mpfr_div(M[kappa] + j, R[kappa] + j, R[j] + j, GMP_RNDN);
+
+            if (!mpfr_number_p(M[kappa] + j))
+            {
+                ret = 0;
+                goto cleanup;
+            }
+
+            if (mpfr_cmpabs(M[kappa] + j, max) > 0)
+                mpfr_abs(max, M[kappa] + j, GMP_RNDN);
+        }
+
+        if (mpfr_cmp_d(max, halfplus) <= 0)
+            break;
+
+        /* 
+           each sweep should shrink the largest |mu|; if two sweeps running 
+           fail to do so, mu is too inaccurate to make progress
+        */
+        if (stalls == -1 || mpfr_cmp(max, prev) < 0)
+        {
+            mpfr_set(prev, max, GMP_RNDN);
+            stalls = 0;
+        }
+        else if (++stalls == 2)
+        {
+            ret = 0;
+            goto cleanup;
+        }
+
+        for (j = kappa - 1; j >= zeros; j--)
+        {
+            mpfr_round(tmp, M[kappa] + j);
+
+            if (!mpfr_zero_p(tmp))
+            {
+                for (i = zeros; i < j; i++)
+                {
+                    mpfr_mul(tmp2, tmp, M[j] + i, GMP_RNDN);
+                    mpfr_sub(M[kappa] + i, M[kappa] + i, tmp2, GMP_RNDN);
+                }
+
+                mpfr_get_z(Z, tmp, GMP_RNDN);
+                fmpz_set_mpz(X, Z);
+                _fmpz_lll_row_submul(B, U, G, kappa, j, X);
+            }
+        }
+    }
+
+    _mpfr_set_fmpz(s + zeros, fmpz_mat_entry(G, kappa, kappa));
+    for (j = zeros; j < kappa; j++)
+    {
+        mpfr_mul(tmp, M[kappa] + j, R[kappa] + j, GMP_RNDN);
+        mpfr_sub(s + j + 1, s + j, tmp, GMP_RNDN);
+    }
+
+cleanup:
+
+    fmpz_clear(X);
+    mpz_clear(Z);
+    mpfr_clear(max);
+    mpfr_clear(prev);
+
+    return ret;
+}
+
+long
+fmpz_lll_mpfr(fmpz_mat_t B, fmpz_mat_t U, const fmpz_t gs_B, 
+                                        mp_bitcnt_t prec, const fmpz_lll_t fl)
+{
+    long d = B->r, kappa, kappa2, zeros;
+    __mpfr_struct ** R, ** M, * s, * t;
+    mpfr_mat_t r, mu;
+    mpfr_t tmp, tmp2, gsB;
+    double ctt, halfplus;
+    int have_gsB;
+    fmpz_mat_t G;
+
+    if (d == 0)
+        return 0;
+
+    /* 
+       slightly stronger conditions than requested, to allow for the 
+       error in the floating point Gram-Schmidt data
+    */
+    ctt = (fl->delta + 1.0)/2;
+    halfplus = (fl->eta + 0.5)/2;
+
+    mpfr_init2(tmp, prec);
+    mpfr_init2(tmp2, prec);
+    mpfr_init2(gsB, prec);
+
+    have_gsB = (gs_B != NULL);
+    if (have_gsB)
+    {
+        _mpfr_set_fmpz(gsB, gs_B);
+        mpfr_mul_d(gsB, gsB, 1.0 + ldexp(1.0, -20), GMP_RNDN);
+    }
+
+    fmpz_mat_init(G, d, d);
+    _fmpz_lll_gram(G, B);
+
+    mpfr_mat_init(r, d, d, prec);
+    mpfr_mat_init(mu, d, d, prec);
+    s = _mpfr_vec_init(d + 1, prec);
+    R = r->rows;
+    M = mu->rows;
+
+    zeros = 0;
+    kappa = 0;
+
+    while (kappa < d)
+    {
+        if (!_fmpz_lll_mpfr_babai(B, U, G, r, mu, s, zeros, kappa, 
+                                                      halfplus, tmp, tmp2))
+        {
+            d = -1;
+            break;
+        }
+
+        /* move zero vectors to the top and start again after them */
+        if (fmpz_is_zero(fmpz_mat_entry(G, kappa, kappa)))
+        {
+            _fmpz_lll_row_move(B, U, G, kappa, zeros);
+            zeros++;
+            kappa = zeros;
+            continue;
+        }
+
+        /* Lovasz condition, find the position to insert b_kappa */
+        kappa2 = kappa;
+        while (kappa > zeros)
+        {
+            mpfr_mul_d(tmp, R[kappa - 1] + kappa - 1, ctt, GMP_RNDN);
+            if (mpfr_cmp(tmp, s + kappa - 1) <= 0)
+                break;
+            kappa--;
+        }
+
+        /* early abort, see fmpz_lll_d */
+        if (have_gsB && kappa == kappa2 && kappa == d - 1 && mpfr_cmp(s + kappa, gsB) > 0)
+        {
+            d--;
+            continue;
+        }
+
+        if (kappa != kappa2)
+        {
+            _fmpz_lll_row_move(B, U, G, kappa2, kappa);
+
+            t = R[kappa2];
+            memmove(R + kappa + 1, R + kappa, 
+                                     (kappa2 - kappa)*sizeof(__mpfr_struct *));
+            R[kappa] = t;
+
+            t = M[kappa2];
+            memmove(M + kappa + 1, M + kappa, 
+                                     (kappa2 - kappa)*sizeof(__mpfr_struct *));
+            M[kappa] = t;
+        }
+
+        mpfr_set(R[kappa] + kappa, s + kappa, GMP_RNDN);
+        kappa++;
+    }
+
+    /* drop any trailing vectors with long projections */
+    if (d != -1 && have_gsB)
+    {
+        while (d > zeros && mpfr_cmp(R[d - 1] + d - 1, gsB) > 0)
+            d--;
+    }
+
+    _mpfr_vec_clear(s, B->r + 1);
+    mpfr_mat_clear(r);
+    mpfr_mat_clear(mu);
+    mpfr_clear(tmp);
+    mpfr_clear(tmp2);
+    mpfr_clear(gsB);
+    fmpz_mat_clear(G);
+
+    return d;
+}
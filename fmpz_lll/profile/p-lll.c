@@ -0,0 +1,132 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "profiler.h"
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mat.h"
+#include "fmpz_lll.h"
+#include "double_extras.h"
+#include "ulong_extras.h"
+
+typedef struct
+{
+    long dim;
+    long bits;
+    int type;
+    int algorithm;
+} lll_t;
+
+static const char * type_str[] = { "knapsack", "ajtai", "ntrulike", "simdioph" };
+
+void sample(void * arg, ulong count)
+{
+    lll_t * params = (lll_t *) arg;
+    long i, dim = params->dim, bits = params->bits;
+    fmpz_mat_t A, B;
+    fmpz_lll_t fl;
+    flint_rand_t state;
+
+    flint_randinit(state);
+    fmpz_lll_context_init_default(fl);
+
+    switch (params->type)
+    {
+        case 0:
+            fmpz_mat_init(A, dim, dim + 1);
+            fmpz_mat_randintrel(A, state, bits);
+            break;
+        case 1:
+            fmpz_mat_init(A, dim, dim);
+            fmpz_mat_randajtai(A, state, 0.5);
+            break;
+        case 2:
+            fmpz_mat_init(A, dim, dim);
+            fmpz_mat_randntrulike(A, state, bits, dim);
+            break;
+        default:
+            fmpz_mat_init(A, dim, dim);
+            fmpz_mat_randsimdioph(A, state, bits, 2*bits);
+    }
+
+    fmpz_mat_init(B, A->r, A->c);
+
+    prof_start();
+
+    for (i = 0; i < count; i++)
+    {
+        fmpz_mat_set(B, A);
+
+        if (params->algorithm == 0)
+            fmpz_lll(B, NULL, fl);
+        else if (params->algorithm == 1)
+            fmpz_lll_d_2exp(B, NULL, NULL, fl);
+        else
+            fmpz_lll_mpfr(B, NULL, NULL, FLINT_MAX(2*D_BITS, 2*B->r), fl);
+    }
+
+    prof_stop();
+
+    fmpz_mat_clear(A);
+    fmpz_mat_clear(B);
+    flint_randclear(state);
+}
+
+int main(void)
+{
+    double min_default, min_2exp, min_mpfr, max;
+    lll_t params;
+    long dim;
+    int type;
+
+    for (type = 0; type < 4; type++)
+    {
+        params.type = type;
+        params.bits = 100;
+
+        printf("fmpz_lll (%s, bits = %ld):\n", type_str[type], params.bits);
+
+        for (dim = 4; dim <= 32; dim *= 2)
+        {
+            params.dim = dim;
+
+            params.algorithm = 0;
+            prof_repeat(&min_default, &max, sample, &params);
+
+            params.algorithm = 1;
+            prof_repeat(&min_2exp, &max, sample, &params);
+
+            params.algorithm = 2;
+            prof_repeat(&min_mpfr, &max, sample, &params);
+
+            printf("dim = %ld default/d_2exp/mpfr %.2f %.2f %.2f (us)\n", 
+                dim, min_default, min_2exp, min_mpfr);
+        }
+    }
+
+    return 0;
+}
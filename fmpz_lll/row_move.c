@@ -0,0 +1,62 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#undef ulong /* avoid clash with stdlib */
+#include <string.h>
+#define ulong unsigned long 
+
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mat.h"
+#include "fmpz_lll.h"
+
+/* move entry k of the array to position j, shifting those in between */
+#define MOVE_ENTRY(arr, T, k, j)                                       \
+    do {                                                               \
+        T __t = (arr)[k];                                              \
+        if ((k) > (j))                                                 \
+            memmove((arr) + (j) + 1, (arr) + (j), ((k) - (j))*sizeof(T)); \
+        else                                                           \
+            memmove((arr) + (k), (arr) + (k) + 1, ((j) - (k))*sizeof(T)); \
+        (arr)[j] = __t;                                                \
+    } while (0)
+
+void
+_fmpz_lll_row_move(fmpz_mat_t B, fmpz_mat_t U, fmpz_mat_t G, long k, long j)
+{
+    long i;
+
+    if (k == j)
+        return;
+
+    MOVE_ENTRY(B->rows, fmpz *, k, j);
+    if (U != NULL)
+        MOVE_ENTRY(U->rows, fmpz *, k, j);
+
+    MOVE_ENTRY(G->rows, fmpz *, k, j);
+    for (i = 0; i < G->r; i++)
+        MOVE_ENTRY(G->rows[i], fmpz, k, j);
+}
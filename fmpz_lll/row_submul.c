@@ -0,0 +1,63 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_mat.h"
+#include "fmpz_lll.h"
+
+void
+_fmpz_lll_row_submul(fmpz_mat_t B, fmpz_mat_t U, fmpz_mat_t G, 
+                                                long k, long j, const fmpz_t X)
+{
+    long i;
+    fmpz * Gk = G->rows[k];
+    fmpz * Gj = G->rows[j];
+    fmpz_t t;
+
+    _fmpz_vec_scalar_submul_fmpz(B->rows[k], B->rows[j], B->c, X);
+    if (U != NULL)
+        _fmpz_vec_scalar_submul_fmpz(U->rows[k], U->rows[j], U->c, X);
+
+    /* <b_k - X b_j, b_k - X b_j> = G_kk - 2 X G_kj + X^2 G_jj */
+    fmpz_init(t);
+    fmpz_mul(t, X, Gj + j);
+    fmpz_sub(t, t, Gk + j);
+    fmpz_sub(t, t, Gk + j);
+    fmpz_addmul(Gk + k, X, t);
+    fmpz_clear(t);
+
+    /* <b_k - X b_j, b_i> = G_ki - X G_ji for i != k */
+    for (i = 0; i < G->c; i++)
+    {
+        if (i != k)
+        {
+            fmpz_submul(Gk + i, X, Gj + i);
+            fmpz_set(G->rows[i] + k, Gk + i);
+        }
+    }
+}
@@ -0,0 +1,135 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mat.h"
+#include "fmpz_lll.h"
+#include "ulong_extras.h"
+
+/* initialise B to a random lattice basis with about d rows */
+static void
+randlattice(fmpz_mat_t B, flint_rand_t state, long d, mp_bitcnt_t bits)
+{
+    switch (n_randint(state, 5))
+    {
+        case 0:
+            fmpz_mat_init(B, d, d + 1);
+            fmpz_mat_randintrel(B, state, bits);
+            break;
+        case 1:
+            fmpz_mat_init(B, d, d);
+            fmpz_mat_randajtai(B, state, 0.5 + 0.25*n_randint(state, 3));
+            break;
+        case 2:
+            fmpz_mat_init(B, 2*((d + 1)/2), 2*((d + 1)/2));
+            fmpz_mat_randntrulike(B, state, bits, n_randint(state, 1000) + 1);
+            break;
+        case 3:
+            fmpz_mat_init(B, d, d);
+            fmpz_mat_randsimdioph(B, state, bits, bits + n_randint(state, 10));
+            break;
+        default: /* linearly dependent rows */
+            fmpz_mat_init(B, d, d + n_randint(state, 3));
+            fmpz_mat_randrank(B, state, n_randint(state, d + 1), bits);
+            fmpz_mat_randops(B, state, n_randint(state, 2*d + 1));
+    }
+}
+
+int
+main(void)
+{
+    long i, j;
+    flint_rand_t state;
+
+    printf("mpfr....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        fmpz_mat_t B, B0, U, T;
+        fmpz_lll_t fl;
+        fmpz_t det;
+        long d = n_randint(state, 16) + 1, zeros, rank, ret;
+        mp_bitcnt_t prec = n_randint(state, 200) + 100;
+        mp_bitcnt_t bits = n_randint(state, 300) + 1;
+
+        if (n_randint(state, 2))
+            fmpz_lll_context_init_default(fl);
+        else
+            fmpz_lll_context_init(fl, 0.75 + 0.01*n_randint(state, 25), 
+                                      0.51 + 0.01*n_randint(state, 20));
+
+        randlattice(B, state, d, bits);
+        d = B->r;
+
+        fmpz_mat_init_set(B0, B);
+        fmpz_mat_init(U, d, d);
+        fmpz_mat_init(T, d, B->c);
+        fmpz_init(det);
+
+        fmpz_mat_one(U);
+        ret = fmpz_lll_mpfr(B, U, NULL, prec, fl);
+
+        fmpz_mat_mul(T, U, B0);
+        fmpz_mat_det(det, U);
+
+        for (zeros = 0; zeros < d; zeros++)
+        {
+            for (j = 0; j < B->c && fmpz_is_zero(fmpz_mat_entry(B, zeros, j)); j++) ;
+            if (j < B->c)
+                break;
+        }
+        rank = fmpz_mat_rank(B0);
+
+        if (ret != d || !fmpz_mat_equal(T, B) || !fmpz_is_pm1(det) 
+            || zeros != d - rank || !fmpz_lll_is_reduced(B, fl))
+        {
+            printf("FAIL:\n");
+            printf("delta = %f, eta = %f\n", fl->delta, fl->eta);
+            printf("B0:\n"); fmpz_mat_print_pretty(B0); printf("\n\n");
+            printf("B:\n"); fmpz_mat_print_pretty(B); printf("\n\n");
+            printf("U:\n"); fmpz_mat_print_pretty(U); printf("\n\n");
+            printf("ret = %ld, zeros = %ld, rank = %ld, prec = %lu\n", ret, zeros, rank, prec);
+            abort();
+        }
+
+        fmpz_mat_clear(B);
+        fmpz_mat_clear(B0);
+        fmpz_mat_clear(U);
+        fmpz_mat_clear(T);
+        fmpz_clear(det);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,192 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mat.h"
+#include "fmpq.h"
+#include "fmpq_mat.h"
+#include "fmpz_lll.h"
+#include "ulong_extras.h"
+
+/* initialise B to a random lattice basis of full rank with about d rows */
+static void
+randlattice(fmpz_mat_t B, flint_rand_t state, long d, mp_bitcnt_t bits)
+{
+    switch (n_randint(state, 4))
+    {
+        case 0:
+            fmpz_mat_init(B, d, d + 1);
+            fmpz_mat_randintrel(B, state, bits);
+            break;
+        case 1:
+            fmpz_mat_init(B, d, d);
+            fmpz_mat_randajtai(B, state, 0.5 + 0.25*n_randint(state, 3));
+            break;
+        case 2:
+            fmpz_mat_init(B, 2*((d + 1)/2), 2*((d + 1)/2));
+            fmpz_mat_randntrulike(B, state, bits, n_randint(state, 1000) + 1);
+            break;
+        default:
+            fmpz_mat_init(B, d, d);
+            fmpz_mat_randsimdioph(B, state, bits, bits + n_randint(state, 10));
+    }
+}
+
+/* set R to the exact Gram-Schmidt data of the rows of B, r_ii on the diagonal */
+static void
+gso(fmpq_mat_t R, const fmpz_mat_t B)
+{
+    long d = B->r, i, j, k;
+    fmpz_mat_t G;
+    fmpq_mat_t mu;
+
+    fmpz_mat_init(G, d, d);
+    fmpq_mat_init(mu, d, d);
+
+    _fmpz_lll_gram(G, B);
+
+    for (i = 0; i < d; i++)
+    {
+        for (j = 0; j <= i; j++)
+        {
+            fmpq * rij = fmpq_mat_entry(R, i, j);
+
+            fmpz_set(fmpq_numref(rij), fmpz_mat_entry(G, i, j));
+            fmpz_one(fmpq_denref(rij));
+
+            for (k = 0; k < j; k++)
+                fmpq_submul(rij, fmpq_mat_entry(mu, j, k), fmpq_mat_entry(R, i, k));
+
+            if (j < i)
+                fmpq_div(fmpq_mat_entry(mu, i, j), rij, fmpq_mat_entry(R, j, j));
+        }
+    }
+
+    fmpz_mat_clear(G);
+    fmpq_mat_clear(mu);
+}
+
+int
+main(void)
+{
+    long i, j, k;
+    flint_rand_t state;
+
+    printf("with_removal....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 300 * flint_test_multiplier(); i++)
+    {
+        fmpz_mat_t B, B0, U, T, K;
+        fmpz_lll_t fl;
+        fmpz_t det, gs_B;
+        fmpq_t bound;
+        fmpq_mat_t R;
+        long d = n_randint(state, 16) + 1, row, ret;
+        mp_bitcnt_t bits = n_randint(state, 200) + 1;
+        int result;
+
+        if (n_randint(state, 2))
+            fmpz_lll_context_init_default(fl);
+        else
+            fmpz_lll_context_init(fl, 0.75 + 0.01*n_randint(state, 25), 
+                                      0.51 + 0.01*n_randint(state, 20));
+
+        randlattice(B, state, d, bits);
+        d = B->r;
+
+        fmpz_mat_init_set(B0, B);
+        fmpz_mat_init(U, d, d);
+        fmpz_mat_init(T, d, B->c);
+        fmpz_init(det);
+        fmpz_init(gs_B);
+        fmpq_init(bound);
+        fmpq_mat_init(R, d, d);
+
+        /* a bound somewhere below the squared length of a random row */
+        row = n_randint(state, d);
+        for (j = 0; j < B->c; j++)
+            fmpz_addmul(gs_B, fmpz_mat_entry(B, row, j), 
+                              fmpz_mat_entry(B, row, j));
+        fmpz_fdiv_q_2exp(gs_B, gs_B, n_randint(state, 2*bits + 1));
+        fmpz_set(fmpq_numref(bound), gs_B);
+
+        fmpz_mat_one(U);
+        ret = fmpz_lll_with_removal(B, U, gs_B, fl);
+
+        fmpz_mat_mul(T, U, B0);
+        fmpz_mat_det(det, U);
+        gso(R, B);
+
+        result = (ret >= 0 && ret <= d && fmpz_mat_equal(T, B) 
+                                       && fmpz_is_pm1(det));
+
+        /* the rows kept are reduced */
+        if (result)
+        {
+            fmpz_mat_init(K, ret, B->c);
+            for (j = 0; j < ret; j++)
+                for (k = 0; k < B->c; k++)
+                    fmpz_set(fmpz_mat_entry(K, j, k), fmpz_mat_entry(B, j, k));
+            result = fmpz_lll_is_reduced(K, fl);
+            fmpz_mat_clear(K);
+        }
+
+        /* the rows removed have Gram-Schmidt norms exceeding the bound */
+        for (j = ret; result && j < d; j++)
+            result = (fmpq_cmp(fmpq_mat_entry(R, j, j), bound) > 0);
+
+        if (!result)
+        {
+            printf("FAIL:\n");
+            printf("delta = %f, eta = %f\n", fl->delta, fl->eta);
+            printf("gs_B = "); fmpz_print(gs_B); printf("\n");
+            printf("B0:\n"); fmpz_mat_print_pretty(B0); printf("\n\n");
+            printf("B:\n"); fmpz_mat_print_pretty(B); printf("\n\n");
+            printf("ret = %ld\n", ret);
+            abort();
+        }
+
+        fmpz_mat_clear(B);
+        fmpz_mat_clear(B0);
+        fmpz_mat_clear(U);
+        fmpz_mat_clear(T);
+        fmpz_clear(det);
+        fmpz_clear(gs_B);
+        fmpq_clear(bound);
+        fmpq_mat_clear(R);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,53 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mat.h"
+#include "double_extras.h"
+#include "fmpz_lll.h"
+
+long
+fmpz_lll_with_removal(fmpz_mat_t B, fmpz_mat_t U, 
+                                     const fmpz_t gs_B, const fmpz_lll_t fl)
+{
+    long ret;
+    mp_bitcnt_t prec;
+
+    /* 
+       Each attempt leaves B reduced as far as it got, so a later attempt 
+       at higher precision or range only has to finish the job
+    */
+    ret = fmpz_lll_d(B, U, gs_B, fl);
+
+    if (ret == -1)
+        ret = fmpz_lll_d_2exp(B, U, gs_B, fl);
+
+    for (prec = FLINT_MAX(2*D_BITS, 2*B->r); ret == -1; prec *= 2)
+        ret = fmpz_lll_mpfr(B, U, gs_B, prec, fl);
+
+    return ret;
+}
@@ -175,6 +175,15 @@ void _fmpz_mat_mul_multi_mod(fmpz_mat_t C, const fmpz_mat_t A,
 void fmpz_mat_mul_multi_mod(fmpz_mat_t C, const fmpz_mat_t A,
     const fmpz_mat_t B);
 
+void _fmpz_mat_mul_strassen_space(long * len, long * rows, 
+                                      long a, long b, long c, long cutoff);
+
+void _fmpz_mat_mul_strassen(fmpz_mat_t C, const fmpz_mat_t A, 
+                 const fmpz_mat_t B, fmpz * T, fmpz ** R, long cutoff);
+
+void fmpz_mat_mul_strassen(fmpz_mat_t C, const fmpz_mat_t A,
+    const fmpz_mat_t B);
+
 void fmpz_mat_sqr(fmpz_mat_t B, const fmpz_mat_t A);
 
 void fmpz_mat_pow(fmpz_mat_t B, const fmpz_mat_t A, ulong exp);
@@ -306,6 +315,15 @@ fmpz_mat_multi_CRT_ui_precomp(fmpz_mat_t mat,
 void fmpz_mat_multi_CRT_ui(fmpz_mat_t mat, nmod_mat_t * const residues,
     long nres, int sign);
 
+/* Tuning parameters *********************************************************/
+
+/* Dimension at or below which Strassen multiplication uses classical */
+#define FMPZ_MAT_MUL_STRASSEN_CUTOFF 8
+
+/* Combined bit size of the entries of A and B above which fmpz_mat_mul 
+   prefers Strassen to classical multiplication */
+#define FMPZ_MAT_MUL_STRASSEN_BITS 1000
+
 #ifdef __cplusplus
 }
 #endif
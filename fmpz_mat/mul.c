@@ -72,7 +72,12 @@ fmpz_mat_mul(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B)
 
         if (5*(ab + bb) > dim * dim || (bits > FLINT_BITS - 3 && dim < 60))
         {
-            fmpz_mat_mul_classical_inline(C, A, B);
+            /* Strassen only pays off once the entry products dominate */
+            if (ab + bb > FMPZ_MAT_MUL_STRASSEN_BITS 
+                && dim >= 2*FMPZ_MAT_MUL_STRASSEN_CUTOFF)
+                fmpz_mat_mul_strassen(C, A, B);
+            else
+                fmpz_mat_mul_classical_inline(C, A, B);
         }
         else
         {
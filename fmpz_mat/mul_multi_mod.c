@@ -30,25 +30,112 @@
 #include "nmod_vec.h"
 #include "nmod_mat.h"
 #include "ulong_extras.h"
+#include "thread_pool.h"
 
+typedef struct
+{
+    const fmpz_mat_struct * mat;
+    nmod_mat_struct * mod;
+    nmod_mat_struct * mod_A;
+    nmod_mat_struct * mod_B;
+    const fmpz_comb_struct * comb;
+    long num_primes;
+    long num_blocks;
+}
+_mul_multi_mod_arg_t;
+
+/*
+   Each block of rows gets its own comb_temp and residue buffer, so that
+   the blocks can be reduced or reconstructed independently; the comb itself
+   is only read.
+*/
+
+static void
+_mod_worker(void * varg, long b)
+{
+    _mul_multi_mod_arg_t * arg = (_mul_multi_mod_arg_t *) varg;
+    const fmpz_mat_struct * mat = arg->mat;
+    long num_primes = arg->num_primes;
+    long start = (b*mat->r)/arg->num_blocks;
+    long stop = ((b + 1)*mat->r)/arg->num_blocks;
+    long i, j, k;
+    fmpz_comb_temp_t comb_temp;
+    mp_limb_t * residues;
+
+    fmpz_comb_temp_init(comb_temp, arg->comb);
+    residues = flint_malloc(sizeof(mp_limb_t) * num_primes);
+
+    for (i = start; i < stop; i++)
+    {
+        for (j = 0; j < mat->c; j++)
+        {
+            fmpz_multi_mod_ui(residues, fmpz_mat_entry(mat, i, j),
+                                                         arg->comb, comb_temp);
+            for (k = 0; k < num_primes; k++)
+                nmod_mat_entry(arg->mod + k, i, j) = residues[k];
+        }
+    }
+
+    flint_free(residues);
+    fmpz_comb_temp_clear(comb_temp);
+}
+
+static void
+_crt_worker(void * varg, long b)
+{
+    _mul_multi_mod_arg_t * arg = (_mul_multi_mod_arg_t *) varg;
+    fmpz_mat_struct * mat = (fmpz_mat_struct *) arg->mat;
+    long num_primes = arg->num_primes;
+    long start = (b*mat->r)/arg->num_blocks;
+    long stop = ((b + 1)*mat->r)/arg->num_blocks;
+    long i, j, k;
+    fmpz_comb_temp_t comb_temp;
+    mp_limb_t * residues;
+
+    fmpz_comb_temp_init(comb_temp, arg->comb);
+    residues = flint_malloc(sizeof(mp_limb_t) * num_primes);
+
+    for (i = start; i < stop; i++)
+    {
+        for (j = 0; j < mat->c; j++)
+        {
+            for (k = 0; k < num_primes; k++)
+                residues[k] = nmod_mat_entry(arg->mod + k, i, j);
+            fmpz_multi_CRT_ui(fmpz_mat_entry(mat, i, j), residues,
+                                                      arg->comb, comb_temp, 1);
+        }
+    }
+
+    flint_free(residues);
+    fmpz_comb_temp_clear(comb_temp);
+}
+
+static void
+_mul_worker(void * varg, long i)
+{
+    _mul_multi_mod_arg_t * arg = (_mul_multi_mod_arg_t *) varg;
+
+    nmod_mat_mul(arg->mod + i, arg->mod_A + i, arg->mod_B + i);
+}
 
 void
 _fmpz_mat_mul_multi_mod(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B,
     long bits)
 {
-    long i, j;
+    long i;
 
     fmpz_comb_t comb;
-    fmpz_comb_temp_t comb_temp;
 
     long num_primes;
     long primes_bits;
+    long num_threads;
     mp_limb_t * primes;
-    mp_limb_t * residues;
 
-    nmod_mat_t * mod_C;
-    nmod_mat_t * mod_A;
-    nmod_mat_t * mod_B;
+    nmod_mat_struct * mod_C;
+    nmod_mat_struct * mod_A;
+    nmod_mat_struct * mod_B;
+
+    _mul_multi_mod_arg_t arg;
 
     primes_bits = NMOD_MAT_OPTIMAL_MODULUS_BITS;
 
@@ -69,67 +156,64 @@ _fmpz_mat_mul_multi_mod(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B,
     for (i = 1; i < num_primes; i++)
         primes[i] = n_nextprime(primes[i-1], 0);
 
-    residues = flint_malloc(sizeof(mp_limb_t) * num_primes);
-
-    mod_A = flint_malloc(sizeof(nmod_mat_t) * num_primes);
-    mod_B = flint_malloc(sizeof(nmod_mat_t) * num_primes);
-    mod_C = flint_malloc(sizeof(nmod_mat_t) * num_primes);
+    mod_A = flint_malloc(sizeof(nmod_mat_struct) * num_primes);
+    mod_B = flint_malloc(sizeof(nmod_mat_struct) * num_primes);
+    mod_C = flint_malloc(sizeof(nmod_mat_struct) * num_primes);
     for (i = 0; i < num_primes; i++)
     {
-        nmod_mat_init(mod_A[i], A->r, A->c, primes[i]);
-        nmod_mat_init(mod_B[i], B->r, B->c, primes[i]);
-        nmod_mat_init(mod_C[i], C->r, C->c, primes[i]);
+        nmod_mat_init(mod_A + i, A->r, A->c, primes[i]);
+        nmod_mat_init(mod_B + i, B->r, B->c, primes[i]);
+        nmod_mat_init(mod_C + i, C->r, C->c, primes[i]);
     }
 
     fmpz_comb_init(comb, primes, num_primes);
-    fmpz_comb_temp_init(comb_temp, comb);
+
+    /*
+       A few blocks of rows per thread lets flint_parallel_do balance rows
+       of uneven size; with a single thread everything is one block.
+    */
+    num_threads = flint_get_num_threads();
+
+    arg.comb = comb;
+    arg.num_primes = num_primes;
+    arg.mod_A = mod_A;
+    arg.mod_B = mod_B;
 
     /* Calculate residues of A */
-    for (i = 0; i < A->r * A->c; i++)
-    {
-        fmpz_multi_mod_ui(residues, &A->entries[i], comb, comb_temp);
-        for (j = 0; j < num_primes; j++)
-            mod_A[j]->entries[i] = residues[j];
-    }
+    arg.mat = A;
+    arg.mod = mod_A;
+    arg.num_blocks = num_threads == 1 ? 1 : FLINT_MIN(A->r, 4*num_threads);
+    flint_parallel_do(_mod_worker, &arg, arg.num_blocks, num_threads);
 
     /* Calculate residues of B */
-    for (i = 0; i < B->r * B->c; i++)
-    {
-        fmpz_multi_mod_ui(residues, &B->entries[i], comb, comb_temp);
-        for (j = 0; j < num_primes; j++)
-            mod_B[j]->entries[i] = residues[j];
-    }
+    arg.mat = B;
+    arg.mod = mod_B;
+    arg.num_blocks = num_threads == 1 ? 1 : FLINT_MIN(B->r, 4*num_threads);
+    flint_parallel_do(_mod_worker, &arg, arg.num_blocks, num_threads);
 
     /* Multiply */
-    for (i = 0; i < num_primes; i++)
-    {
-        nmod_mat_mul(mod_C[i], mod_A[i], mod_B[i]);
-    }
+    arg.mod = mod_C;
+    flint_parallel_do(_mul_worker, &arg, num_primes, num_threads);
 
     /* Chinese remaindering */
-    for (i = 0; i < C->r * C->c; i++)
-    {
-        for (j = 0; j < num_primes; j++)
-            residues[j] = mod_C[j]->entries[i];
-        fmpz_multi_CRT_ui(&C->entries[i], residues, comb, comb_temp, 1);
-    }
+    arg.mat = C;
+    arg.num_blocks = num_threads == 1 ? 1 : FLINT_MIN(C->r, 4*num_threads);
+    flint_parallel_do(_crt_worker, &arg, arg.num_blocks, num_threads);
 
     /* Cleanup */
     for (i = 0; i < num_primes; i++)
     {
-        nmod_mat_clear(mod_A[i]);
-        nmod_mat_clear(mod_B[i]);
-        nmod_mat_clear(mod_C[i]);
+        nmod_mat_clear(mod_A + i);
+        nmod_mat_clear(mod_B + i);
+        nmod_mat_clear(mod_C + i);
     }
 
     flint_free(mod_A);
     flint_free(mod_B);
     flint_free(mod_C);
 
-    fmpz_comb_temp_clear(comb_temp);
     fmpz_comb_clear(comb);
 
-    flint_free(residues);
     flint_free(primes);
 }
 
@@ -0,0 +1,248 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_mat.h"
+
+/* 
+   Sets W to the window of M with rows r1, ..., r2 - 1 and columns 
+   c1, ..., c2 - 1, taking the row pointers from rows
+*/
+static void
+_fmpz_mat_window(fmpz_mat_t W, const fmpz_mat_t M, 
+                               long r1, long c1, long r2, long c2, fmpz ** rows)
+{
+    long i;
+
+    for (i = 0; i < r2 - r1; i++)
+        rows[i] = M->rows[r1 + i] + c1;
+
+    W->entries = NULL;
+    W->rows = rows;
+    W->r = r2 - r1;
+    W->c = c2 - c1;
+}
+
+/* 
+   Sets W to an r by c temporary with row length len, using the entries 
+   of T and the row pointers of rows
+*/
+static void
+_fmpz_mat_temp(fmpz_mat_t W, long r, long c, long len, fmpz * T, fmpz ** rows)
+{
+    long i;
+
+    for (i = 0; i < r; i++)
+        rows[i] = T + i*len;
+
+    W->entries = T;
+    W->rows = rows;
+    W->r = r;
+    W->c = c;
+}
+
+void
+_fmpz_mat_mul_strassen_space(long * len, long * rows, 
+                                         long a, long b, long c, long cutoff)
+{
+    long anr, anc, bnc;
+
+    *len = 0;
+    *rows = 0;
+
+    while (a > cutoff && b > cutoff && c > cutoff)
+    {
+        anr = a / 2;
+        anc = b / 2;
+        bnc = c / 2;
+
+        *len += anr*FLINT_MAX(anc, bnc) + anc*bnc;
+        *rows += 9*anr + 5*anc;
+
+        a = anr;
+        b = anc;
+        c = bnc;
+    }
+}
+
+void
+_fmpz_mat_mul_strassen(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B,
+                                           fmpz * T, fmpz ** R, long cutoff)
+{
+    long a, b, c, i, j;
+    long anr, anc, bnr, bnc, len;
+
+    fmpz_mat_t A11, A12, A21, A22;
+    fmpz_mat_t B11, B12, B21, B22;
+    fmpz_mat_t C11, C12, C21, C22;
+    fmpz_mat_t X1, X2;
+
+    a = A->r;
+    b = A->c;
+    c = B->c;
+
+    if (a <= cutoff || b <= cutoff || c <= cutoff)
+    {
+        fmpz_mat_mul_classical_inline(C, A, B);
+        return;
+    }
+
+    anr = a / 2;
+    anc = b / 2;
+    bnr = anc;
+    bnc = c / 2;
+
+    _fmpz_mat_window(A11, A, 0, 0, anr, anc, R);
+    _fmpz_mat_window(A12, A, 0, anc, anr, 2*anc, R + anr);
+    _fmpz_mat_window(A21, A, anr, 0, 2*anr, anc, R + 2*anr);
+    _fmpz_mat_window(A22, A, anr, anc, 2*anr, 2*anc, R + 3*anr);
+    R += 4*anr;
+
+    _fmpz_mat_window(B11, B, 0, 0, bnr, bnc, R);
+    _fmpz_mat_window(B12, B, 0, bnc, bnr, 2*bnc, R + bnr);
+    _fmpz_mat_window(B21, B, bnr, 0, 2*bnr, bnc, R + 2*bnr);
+    _fmpz_mat_window(B22, B, bnr, bnc, 2*bnr, 2*bnc, R + 3*bnr);
+    R += 4*bnr;
+
+    _fmpz_mat_window(C11, C, 0, 0, anr, bnc, R);
+    _fmpz_mat_window(C12, C, 0, bnc, anr, 2*bnc, R + anr);
+    _fmpz_mat_window(C21, C, anr, 0, 2*anr, bnc, R + 2*anr);
+    _fmpz_mat_window(C22, C, anr, bnc, 2*anr, 2*bnc, R + 3*anr);
+    R += 4*anr;
+
+    /*
+        The temporaries are carved out of T, and the recursive calls use 
+        the space after them. As the products at each level are computed
+        one after another, the same entries, and the limbs they have 
+        already allocated, are reused throughout the recursion.
+    */
+    len = FLINT_MAX(bnc, anc);
+    _fmpz_mat_temp(X1, anr, anc, len, T, R);
+    T += anr*len;
+    R += anr;
+    _fmpz_mat_temp(X2, anc, bnc, bnc, T, R);
+    T += anc*bnc;
+    R += anc;
+
+    /*
+        See Jean-Guillaume Dumas, Clement Pernet, Wei Zhou; "Memory
+        efficient scheduling of Strassen-Winograd's matrix multiplication
+        algorithm"; http://arxiv.org/pdf/0707.2347v3 for reference on the
+        used operation scheduling.
+    */
+
+    fmpz_mat_sub(X1, A11, A21);
+    fmpz_mat_sub(X2, B22, B12);
+    _fmpz_mat_mul_strassen(C21, X1, X2, T, R, cutoff);
+
+    fmpz_mat_add(X1, A21, A22);
+    fmpz_mat_sub(X2, B12, B11);
+    _fmpz_mat_mul_strassen(C22, X1, X2, T, R, cutoff);
+
+    fmpz_mat_sub(X1, X1, A11);
+    fmpz_mat_sub(X2, B22, X2);
+    _fmpz_mat_mul_strassen(C12, X1, X2, T, R, cutoff);
+
+    fmpz_mat_sub(X1, A12, X1);
+    _fmpz_mat_mul_strassen(C11, X1, B22, T, R, cutoff);
+
+    X1->c = bnc;
+    _fmpz_mat_mul_strassen(X1, A11, B11, T, R, cutoff);
+
+    fmpz_mat_add(C12, X1, C12);
+    fmpz_mat_add(C21, C12, C21);
+    fmpz_mat_add(C12, C12, C22);
+    fmpz_mat_add(C22, C21, C22);
+    fmpz_mat_add(C12, C12, C11);
+    fmpz_mat_sub(X2, X2, B21);
+    _fmpz_mat_mul_strassen(C11, A22, X2, T, R, cutoff);
+
+    fmpz_mat_sub(C21, C21, C11);
+    _fmpz_mat_mul_strassen(C11, A12, B21, T, R, cutoff);
+
+    fmpz_mat_add(C11, X1, C11);
+
+    if (c > 2*bnc) /* A by last col of B -> last col of C */
+    {
+        for (i = 0; i < a; i++)
+        {
+            fmpz * t = fmpz_mat_entry(C, i, c - 1);
+
+            fmpz_zero(t);
+            for (j = 0; j < b; j++)
+                fmpz_addmul(t, fmpz_mat_entry(A, i, j), 
+                               fmpz_mat_entry(B, j, c - 1));
+        }
+    }
+
+    if (a > 2*anr) /* last row of A by B -> last row of C */
+    {
+        for (i = 0; i < 2*bnc; i++)
+        {
+            fmpz * t = fmpz_mat_entry(C, a - 1, i);
+
+            fmpz_zero(t);
+            for (j = 0; j < b; j++)
+                fmpz_addmul(t, fmpz_mat_entry(A, a - 1, j), 
+                               fmpz_mat_entry(B, j, i));
+        }
+    }
+
+    if (b > 2*anc) /* last col of A by last row of B -> C */
+    {
+        for (i = 0; i < 2*anr; i++)
+            _fmpz_vec_scalar_addmul_fmpz(C->rows[i], B->rows[b - 1], 2*bnc,
+                                         fmpz_mat_entry(A, i, b - 1));
+    }
+}
+
+void
+fmpz_mat_mul_strassen(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B)
+{
+    long len, rows;
+    fmpz * T;
+    fmpz ** R;
+
+    _fmpz_mat_mul_strassen_space(&len, &rows, A->r, A->c, B->c, 
+                                              FMPZ_MAT_MUL_STRASSEN_CUTOFF);
+
+    if (rows == 0)
+    {
+        fmpz_mat_mul_classical_inline(C, A, B);
+        return;
+    }
+
+    T = _fmpz_vec_init(len);
+    R = flint_malloc(rows*sizeof(fmpz *));
+
+    _fmpz_mat_mul_strassen(C, A, B, T, R, FMPZ_MAT_MUL_STRASSEN_CUTOFF);
+
+    _fmpz_vec_clear(T, len);
+    flint_free(R);
+}
@@ -56,8 +56,9 @@ int main(void)
         fmpz_mat_init(C, m, k);
         fmpz_mat_init(D, m, k);
 
-        fmpz_mat_randtest(A, state, n_randint(state, 200) + 1);
-        fmpz_mat_randtest(B, state, n_randint(state, 200) + 1);
+        /* Large enough entries to select Strassen multiplication */
+        fmpz_mat_randtest(A, state, n_randint(state, 800) + 1);
+        fmpz_mat_randtest(B, state, n_randint(state, 800) + 1);
 
         /* Make sure noise in the output is ok */
         fmpz_mat_randtest(C, state, n_randint(state, 200) + 1);
@@ -0,0 +1,130 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_mat.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    fmpz_mat_t A, B, C, D;
+    long i;
+    flint_rand_t state;
+
+    printf("mul_strassen....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 100 * flint_test_multiplier(); i++)
+    {
+        long m, n, k;
+
+        m = n_randint(state, 50);
+        n = n_randint(state, 50);
+        k = n_randint(state, 50);
+
+        fmpz_mat_init(A, m, n);
+        fmpz_mat_init(B, n, k);
+        fmpz_mat_init(C, m, k);
+        fmpz_mat_init(D, m, k);
+
+        fmpz_mat_randtest(A, state, n_randint(state, 200) + 1);
+        fmpz_mat_randtest(B, state, n_randint(state, 200) + 1);
+
+        /* Make sure noise in the output is ok */
+        fmpz_mat_randtest(D, state, n_randint(state, 200) + 1);
+
+        fmpz_mat_mul_classical_inline(C, A, B);
+        fmpz_mat_mul_strassen(D, A, B);
+
+        if (!fmpz_mat_equal(C, D))
+        {
+            printf("FAIL: results not equal\n");
+            abort();
+        }
+
+        fmpz_mat_clear(A);
+        fmpz_mat_clear(B);
+        fmpz_mat_clear(C);
+        fmpz_mat_clear(D);
+    }
+
+    /* Check deep recursion, reusing the same temporary space twice */
+    for (i = 0; i < 100 * flint_test_multiplier(); i++)
+    {
+        long m, n, k, j, cutoff, len, rows;
+        fmpz * T;
+        fmpz ** R;
+
+        m = n_randint(state, 50);
+        n = n_randint(state, 50);
+        k = n_randint(state, 50);
+        cutoff = n_randint(state, 8) + 1;
+
+        fmpz_mat_init(A, m, n);
+        fmpz_mat_init(B, n, k);
+        fmpz_mat_init(C, m, k);
+        fmpz_mat_init(D, m, k);
+
+        _fmpz_mat_mul_strassen_space(&len, &rows, m, n, k, cutoff);
+        T = _fmpz_vec_init(len + 1);
+        R = flint_malloc((rows + 1)*sizeof(fmpz *));
+
+        for (j = 0; j < 2; j++)
+        {
+            fmpz_mat_randtest(A, state, n_randint(state, 200) + 1);
+            fmpz_mat_randtest(B, state, n_randint(state, 200) + 1);
+            fmpz_mat_randtest(D, state, n_randint(state, 200) + 1);
+
+            fmpz_mat_mul_classical_inline(C, A, B);
+            _fmpz_mat_mul_strassen(D, A, B, T, R, cutoff);
+
+            if (!fmpz_mat_equal(C, D))
+            {
+                printf("FAIL: results not equal (cutoff = %ld)\n", cutoff);
+                abort();
+            }
+        }
+
+        _fmpz_vec_clear(T, len + 1);
+        flint_free(R);
+
+        fmpz_mat_clear(A);
+        fmpz_mat_clear(B);
+        fmpz_mat_clear(C);
+        fmpz_mat_clear(D);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
@@ -37,7 +37,8 @@ void _fmpz_poly_mullow_SS(fmpz * output, const fmpz * input1, long len1,
     long n = (1L << (loglen - 2));
 
     long output_bits, limbs, size, i;
-    mp_limb_t * ptr, * t1, * t2, * tt, * s1, ** ii, ** jj;
+    long num_threads = flint_get_num_threads();
+    mp_limb_t * ptr, ** t1, ** t2, * tt, ** s1, ** ii, ** jj;
     long bits1, bits2;
     int sign = 0;
 
@@ -56,13 +57,21 @@ void _fmpz_poly_mullow_SS(fmpz * output, const fmpz * input1, long len1,
     size = limbs + 1;
 
     /* allocate space for ffts */
-    ii = flint_malloc((4*(n + n*size) + 5*size)*sizeof(mp_limb_t));
+    ii = flint_malloc(4*(n + n*size)*sizeof(mp_limb_t));
     for (i = 0, ptr = (mp_limb_t *) ii + 4*n; i < 4*n; i++, ptr += size) 
         ii[i] = ptr;
-    t1 = ptr;
-    t2 = t1 + size;
-    s1 = t2 + size;
-    tt = s1 + size;
+
+    /* one set of temporaries per thread */
+    t1 = flint_malloc(num_threads*(3 + 5*size)*sizeof(mp_limb_t));
+    t2 = t1 + num_threads;
+    s1 = t2 + num_threads;
+    for (i = 0, ptr = (mp_limb_t *) t1 + 3*num_threads; i < num_threads; i++, ptr += 3*size)
+    {
+        t1[i] = ptr;
+        t2[i] = ptr + size;
+        s1[i] = ptr + 2*size;
+    }
+    tt = ptr;
 
     if (input1 != input2)
     {
@@ -100,11 +109,12 @@ void _fmpz_poly_mullow_SS(fmpz * output, const fmpz * input1, long len1,
     limbs = (output_bits - 1) / FLINT_BITS + 1;
     limbs = fft_adjust_limbs(limbs); /* round up limbs for Nussbaumer */
     
-    fft_convolution(ii, jj, loglen - 2, limbs, len_out, &t1, &t2, &s1, tt); 
+    fft_convolution(ii, jj, loglen - 2, limbs, len_out, t1, t2, s1, tt); 
 
     _fmpz_vec_set_fft(output, trunc, ii, limbs, sign); /* write output */
 
     flint_free(ii); 
+    flint_free(t1);
     if (input1 != input2) 
         flint_free(jj);
 }
@@ -27,15 +27,46 @@
 #include <stdio.h>
 #include "flint.h"
 
+static void * (* __flint_allocate_func)(size_t) = malloc;
+static void * (* __flint_callocate_func)(size_t, size_t) = calloc;
+static void * (* __flint_reallocate_func)(void *, size_t) = realloc;
+static void (* __flint_free_func)(void *) = free;
+
 static void flint_memory_error()
 {
     printf("Exception (FLINT memory_manager). Unable to allocate memory.\n");
     abort();
 }
 
+void flint_set_memory_functions(void * (* alloc_func)(size_t),
+                                void * (* calloc_func)(size_t, size_t),
+                                void * (* realloc_func)(void *, size_t),
+                                void (* free_func)(void *))
+{
+    __flint_allocate_func = (alloc_func == NULL) ? malloc : alloc_func;
+    __flint_callocate_func = (calloc_func == NULL) ? calloc : calloc_func;
+    __flint_reallocate_func = (realloc_func == NULL) ? realloc : realloc_func;
+    __flint_free_func = (free_func == NULL) ? free : free_func;
+}
+
+void flint_get_memory_functions(void * (** alloc_func)(size_t),
+                                void * (** calloc_func)(size_t, size_t),
+                                void * (** realloc_func)(void *, size_t),
+                                void (** free_func)(void *))
+{
+    if (alloc_func != NULL)
+        *alloc_func = __flint_allocate_func;
+    if (calloc_func != NULL)
+        *calloc_func = __flint_callocate_func;
+    if (realloc_func != NULL)
+        *realloc_func = __flint_reallocate_func;
+    if (free_func != NULL)
+        *free_func = __flint_free_func;
+}
+
 void * flint_malloc(size_t size)
 {
-    void * ptr = malloc(size);
+    void * ptr = __flint_allocate_func(size);
 
     if (ptr == NULL)
         flint_memory_error();
@@ -45,7 +76,7 @@ void * flint_malloc(size_t size)
 
 void * flint_realloc(void * ptr, size_t size)
 {
-    void * ptr2 = realloc(ptr, size);
+    void * ptr2 = __flint_reallocate_func(ptr, size);
 
     if (ptr2 == NULL)
         flint_memory_error();
@@ -55,7 +86,7 @@ void * flint_realloc(void * ptr, size_t size)
 
 void * flint_calloc(size_t num, size_t size)
 {
-    void * ptr = calloc(num, size);
+    void * ptr = __flint_callocate_func(num, size);
 
     if (ptr == NULL)
         flint_memory_error();
@@ -65,5 +96,121 @@ void * flint_calloc(size_t num, size_t size)
 
 void flint_free(void * ptr)
 {
-    free(ptr);
+    __flint_free_func(ptr);
+}
+
+/*
+   Temporary space: each thread has a stack of chunks obtained from
+   flint_malloc. Allocations bump the used count of the top chunk and a 
+   mark records the top chunk and its used count, so that releasing a 
+   mark frees everything allocated since in one go. The largest chunk 
+   freed, up to FLINT_TMP_MAX_SPARE bytes, is kept back as a spare so that 
+   repeated calls with the same needs do not go back to flint_malloc.
+*/
+
+/* All allocations are rounded up to a multiple of this many bytes */
+#define FLINT_TMP_ALIGN 16
+
+/* Minimum size of a chunk in bytes */
+#define FLINT_TMP_CHUNK_SIZE 65536
+
+/* Always free larger chunks to avoid holding on to too much heap space */
+#define FLINT_TMP_MAX_SPARE (16*FLINT_TMP_CHUNK_SIZE)
+
+typedef struct flint_tmp_chunk_struct
+{
+    struct flint_tmp_chunk_struct * prev;
+    size_t size;
+    size_t used;
+} flint_tmp_chunk_struct;
+
+#define FLINT_TMP_HEADER \
+    ((sizeof(flint_tmp_chunk_struct) + FLINT_TMP_ALIGN - 1) \
+                                                    & ~(size_t) (FLINT_TMP_ALIGN - 1))
+
+__thread flint_tmp_chunk_struct * flint_tmp_top = NULL;
+__thread flint_tmp_chunk_struct * flint_tmp_spare = NULL;
+
+void flint_tmp_mark(flint_tmp_mark_t mark)
+{
+    mark->chunk = flint_tmp_top;
+    mark->used = (flint_tmp_top == NULL) ? 0 : flint_tmp_top->used;
+}
+
+void * flint_tmp_alloc(size_t size)
+{
+    flint_tmp_chunk_struct * chunk = flint_tmp_top;
+    void * ptr;
+
+    size = (size + FLINT_TMP_ALIGN - 1) & ~(size_t) (FLINT_TMP_ALIGN - 1);
+
+    if (chunk == NULL || chunk->size - chunk->used < size)
+    {
+        if (flint_tmp_spare != NULL && flint_tmp_spare->size >= size)
+        {
+            chunk = flint_tmp_spare;
+            flint_tmp_spare = NULL;
+        }
+        else
+        {
+            size_t chunk_size = FLINT_MAX(size, FLINT_TMP_CHUNK_SIZE);
+
+            if (flint_tmp_top != NULL)
+                chunk_size = FLINT_MAX(chunk_size, 2*flint_tmp_top->size);
+
+            chunk = flint_malloc(FLINT_TMP_HEADER + chunk_size);
+            chunk->size = chunk_size;
+        }
+
+        chunk->used = 0;
+        chunk->prev = flint_tmp_top;
+        flint_tmp_top = chunk;
+    }
+
+    ptr = (char *) chunk + FLINT_TMP_HEADER + chunk->used;
+    chunk->used += size;
+
+    return ptr;
+}
+
+void flint_tmp_release(flint_tmp_mark_t mark)
+{
+    flint_tmp_chunk_struct * chunk = mark->chunk;
+
+    while (flint_tmp_top != chunk)
+    {
+        flint_tmp_chunk_struct * top = flint_tmp_top;
+
+        flint_tmp_top = top->prev;
+
+        if (top->size > FLINT_TMP_MAX_SPARE)
+            flint_free(top);
+        else if (flint_tmp_spare == NULL)
+            flint_tmp_spare = top;
+        else if (flint_tmp_spare->size < top->size)
+        {
+            flint_free(flint_tmp_spare);
+            flint_tmp_spare = top;
+        }
+        else
+            flint_free(top);
+    }
+
+    if (chunk != NULL)
+        chunk->used = mark->used;
+}
+
+void flint_tmp_cleanup(void)
+{
+    flint_tmp_mark_t mark;
+
+    mark->chunk = NULL;
+    mark->used = 0;
+    flint_tmp_release(mark);
+
+    if (flint_tmp_spare != NULL)
+    {
+        flint_free(flint_tmp_spare);
+        flint_tmp_spare = NULL;
+    }
 }
@@ -43,9 +43,11 @@ _apply_permutation(long * AP, nmod_mat_t A, long * P,
         mp_ptr * Atmp;
         long * APtmp;
         long i;
+        TMP_INIT;
 
-        Atmp = flint_malloc(sizeof(mp_ptr) * n);
-        APtmp = flint_malloc(sizeof(long) * n);
+        TMP_START;
+        Atmp = TMP_ALLOC(sizeof(mp_ptr) * n);
+        APtmp = TMP_ALLOC(sizeof(long) * n);
 
         for (i = 0; i < n; i++) Atmp[i] = A->rows[P[i] + offset];
         for (i = 0; i < n; i++) A->rows[i + offset] = Atmp[i];
@@ -53,8 +55,7 @@ _apply_permutation(long * AP, nmod_mat_t A, long * P,
         for (i = 0; i < n; i++) APtmp[i] = AP[P[i] + offset];
         for (i = 0; i < n; i++) AP[i + offset] = APtmp[i];
 
-        flint_free(Atmp);
-        flint_free(APtmp);
+        TMP_END;
     }
 }
 
@@ -65,6 +66,7 @@ nmod_mat_lu_recursive(long * P, nmod_mat_t A, int rank_check)
     long i, j, m, n, r1, r2, n1;
     nmod_mat_t A0, A1, A00, A01, A10, A11;
     long * P1;
+    TMP_INIT;
 
     m = A->r;
     n = A->c;
@@ -80,7 +82,8 @@ nmod_mat_lu_recursive(long * P, nmod_mat_t A, int rank_check)
     for (i = 0; i < m; i++)
         P[i] = i;
 
-    P1 = flint_malloc(sizeof(long) * m);
+    TMP_START;
+    P1 = TMP_ALLOC(sizeof(long) * m);
     nmod_mat_window_init(A0, A, 0, 0, m, n1);
     nmod_mat_window_init(A1, A, 0, n1, m, n);
 
@@ -88,7 +91,7 @@ nmod_mat_lu_recursive(long * P, nmod_mat_t A, int rank_check)
 
     if (rank_check && (r1 != n1))
     {
-        flint_free(P1);
+        TMP_END;
         nmod_mat_window_clear(A0);
         nmod_mat_window_clear(A1);
         return 0;
@@ -135,7 +138,7 @@ nmod_mat_lu_recursive(long * P, nmod_mat_t A, int rank_check)
         }
     }
 
-    flint_free(P1);
+    TMP_END;
     nmod_mat_window_clear(A00);
     nmod_mat_window_clear(A01);
     nmod_mat_window_clear(A10);
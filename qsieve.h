@@ -78,11 +78,55 @@ typedef struct la_col_t /* matrix column */
 	long orig;         /* Original relation number */
 } la_col_t;
 
+/*
+   Polynomial data for the self-initialising quadratic sieve, which 
+   sieves with the polynomials (Ax + B)^2 - kn = A(Ax^2 + 2Bx + C) 
+   for x in [-M, M) where 2M is the sieve size
+*/
+typedef struct qs_poly_s
+{
+   fmpz_t A; /* coefficient A */
+   fmpz_t B; /* coefficient B */
+   fmpz_t C; /* coefficient C */
+
+   long s; /* number of prime factors of A */
+   long * A_ind; /* indices of factor base primes dividing A */
+
+   fmpz * B_terms; /* 
+                      B_terms[j] = (A/q) * (sqrt(kn)/(A/q) mod q) where q
+                      is the j-th prime factor of A, taking the smaller
+                      square root, so that B is a signed sum of B_terms
+                   */
+
+   mp_limb_t * A_inv; /* A^(-1) mod p */
+   mp_limb_t ** A_inv2B; /* A_inv2B[j][i] = 2*B_terms[j]*A^(-1) mod p */
+
+   mp_limb_t * soln1; /* first root of poly, or -1 for factors of A */
+   mp_limb_t * soln2; /* second root of poly */
+
+   long * posn1; /* next sieve position of first root */
+   long * posn2; /* next sieve position of second root */
+
+   fac_t * factor; /* factors of the relation being evaluated */
+
+   long max_factors; /* maximum number of factors of a relation */
+   fmpz * rel_Y; /* Y values of the relations found with this A */
+   mp_limb_t * rel_L; /* their large primes, 1 for full relations */
+   fac_t * rel_fac; /* their factors, max_factors entries each */
+   long * rel_num; /* their numbers of factors */
+   long num_rels; /* number of relations waiting to be added */
+   long rel_alloc; /* number of relations there is space for */
+} qs_poly_s;
+
+typedef qs_poly_s qs_poly_t[1];
+
 typedef struct qs_s
 {
    mp_limb_t hi; /* Number to factor */
    mp_limb_t lo;
 
+   fmpz_t n; /* Number to factor as a multiprecision integer */
+
    mp_bitcnt_t bits; /* Number of bits of n */
    
    ulong ks_primes; /* number of Knuth-Schroeppel primes */
@@ -172,6 +216,36 @@ typedef struct qs_s
 
    long * prime_count; /* counts of the exponents of primes appearing in the square */
 
+   /*********************
+     SIQS data
+   **********************/
+
+   qs_poly_s * poly; /* current polynomial of each thread */
+   long num_threads; /* number of A coeffs sieved at the same time */
+
+   fmpz_t target_A_mp; /* target value for A coeff, for qsieve_factor */
+   fmpz * A_used; /* A coeffs used so far */
+   long num_A_used;
+   long A_used_alloc;
+
+   flint_rand_t state; /* random state for choosing A coeffs */
+
+   unsigned char sieve_thresh; /* sieve value for a candidate relation */
+
+   mp_limb_t large_prime; /* bound on the large prime of a partial relation */
+
+   mp_limb_t * lp_prime; /* large primes of partial relations */
+   fmpz * lp_Y; /* Y values of partial relations */
+   long * lp_off; /* offsets of the partial relations in lp_rel */
+   long * lp_rel; /* number of factors then factors of each partial relation */
+   long lp_rel_len; /* number of entries of lp_rel used */
+   long lp_rel_alloc; /* number of entries of lp_rel allocated */
+   long * lp_hash; /* open addressing table of first partial with each prime */
+   long lp_hash_mask; /* size of lp_hash minus one */
+   long num_partials; /* number of partial relations stored */
+   long lp_alloc; /* number of partial relations there is space for */
+   long num_combined; /* number of relations made from pairs of partials */
+
    /*********************
      Statistics
    **********************/
@@ -212,6 +286,39 @@ static const mp_limb_t qsieve_ll_tune[][5] =
 /* number of entries in the tuning table */
 #define QS_LL_TUNE_SIZE (sizeof(qsieve_ll_tune)/(5*sizeof(mp_limb_t)))
 
+/*
+   Tuning parameters { bits, ks_primes, fb_primes, small_primes, sieve_size } 
+   for qsieve_factor as for qsieve_ll_factor, except that small_primes 
+   includes k, 2 and the sign of the relation
+*/
+static const mp_limb_t qsieve_tune[][5] =
+{
+    {0,    50,     60,  4,   8000 },
+    {80,   50,    120,  5,  12000 },
+    {100, 100,    250,  6,  24000 },
+    {120, 100,    400,  7,  32000 },
+    {140, 100,    700,  8,  65536 },
+    {160, 150,   1000,  9,  65536 },
+    {180, 150,   2000, 10,  65536 },
+    {200, 150,   3000, 10,  65536 },
+    {220, 150,   6000, 11, 131072 },
+    {240, 200,  12000, 12, 196608 },
+    {260, 200,  30000, 12, 196608 },
+    {280, 200,  50000, 13, 196608 },
+    {300, 200,  60000, 13, 262144 },
+    {320, 200,  80000, 14, 393216 },
+    {340, 200, 100000, 14, 393216 }
+};
+
+/* number of entries in the tuning table */
+#define QS_TUNE_SIZE (sizeof(qsieve_tune)/(5*sizeof(mp_limb_t)))
+
+#define QS_A_PRIME_BITS 11 /* preferred number of bits of factors of A */
+
+#define QS_LARGE_PRIME_MULT 256 /* large prime bound as multiple of FB bound */
+
+#define QS_THRESH_ADJUST 16 /* bits below the size of a partial relation to sieve to */
+
 #define P_GOODNESS 100 /* within what factor of target_A must A be */
 #define P_GOODNESS2 200 /* within what factor of target_A must A be when s = 2 */
 
@@ -292,6 +399,50 @@ static __inline__ void free_col(la_col_t * col)
    if (col->weight) flint_free(col->data);
 }
 
+void qsieve_init(qs_t qs_inf, const fmpz_t n);
+
+void qsieve_clear(qs_t qs_inf);
+
+mp_limb_t qsieve_primes_init(qs_t qs_inf);
+
+void qsieve_linalg_init(qs_t qs_inf);
+
+void qsieve_poly_init(qs_poly_t poly, qs_t qs_inf);
+
+void qsieve_poly_clear(qs_poly_t poly);
+
+void qsieve_compute_A(qs_t qs_inf, qs_poly_t poly);
+
+void qsieve_compute_C(qs_t qs_inf, qs_poly_t poly);
+
+void qsieve_compute_poly_data(qs_t qs_inf, qs_poly_t poly);
+
+void qsieve_next_poly(qs_t qs_inf, qs_poly_t poly, long poly_index);
+
+void qsieve_do_sieving(qs_t qs_inf, qs_poly_t poly, 
+                                  unsigned char * sieve, long start, long len);
+
+int qsieve_evaluate_candidate(qs_t qs_inf, qs_poly_t poly, long i);
+
+long qsieve_evaluate_sieve(qs_t qs_inf, qs_poly_t poly, 
+                                  unsigned char * sieve, long start, long len);
+
+long qsieve_sieve_poly(qs_t qs_inf, qs_poly_t poly, unsigned char * sieve);
+
+long qsieve_sieve_A(qs_t qs_inf, qs_poly_t poly, unsigned char * sieve);
+
+long qsieve_collect_relations(qs_t qs_inf, unsigned char * sieve);
+
+void qsieve_add_relation(qs_t qs_inf, fmpz_t Y, mp_limb_t L, 
+                                                    fac_t * fac, long num);
+
+void qsieve_store_relation(qs_poly_t poly, fmpz_t Y, mp_limb_t L, 
+                                                    fac_t * fac, long num);
+
+long qsieve_flush_relations(qs_t qs_inf, qs_poly_t poly);
+
+int qsieve_factor(fmpz_t factor, const fmpz_t n);
+
 uint64_t get_null_entry(uint64_t * nullrows, long i, long l);
 
 void reduce_matrix(qs_t qs_inf, long * nrows, long * ncols, la_col_t * cols);
@@ -0,0 +1,258 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#undef ulong /* avoid clash with stdlib */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#define ulong unsigned long 
+
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "qsieve.h"
+#include "fmpz.h"
+
+/* Insert a full relation into the matrix */
+static void 
+qsieve_insert_full(qs_t qs_inf, fmpz_t Y, fac_t * fac, long num)
+{
+   long i;
+
+   if (num >= qs_inf->max_factors) /* too many factors to store */
+      return;
+
+   if (qs_inf->num_relations >= qs_inf->buffer_size)
+   {
+      printf("Error: too many duplicate relations!\n");
+      printf("s = %ld, bits = %ld\n", qs_inf->s, qs_inf->bits);
+      abort();
+   }
+
+   for (i = 0; i < num; i++)
+      qs_inf->factor[i] = fac[i];
+   qs_inf->num_factors = num;
+
+   qsieve_ll_insert_relation(qs_inf, Y);
+}
+
+/* Find the slot of the hash table for the large prime L */
+static long 
+qsieve_lp_slot(qs_t qs_inf, mp_limb_t L)
+{
+   long h = (L >> 1) & qs_inf->lp_hash_mask;
+
+   while (qs_inf->lp_hash[h] != -1 && qs_inf->lp_prime[qs_inf->lp_hash[h]] != L)
+      h = (h + 1) & qs_inf->lp_hash_mask;
+
+   return h;
+}
+
+/* Store a partial relation whose large prime has not been seen before */
+static void 
+qsieve_store_partial(qs_t qs_inf, fmpz_t Y, mp_limb_t L, 
+                                             fac_t * fac, long num, long h)
+{
+   long i, j, * rel;
+
+   if (qs_inf->num_partials == qs_inf->lp_alloc)
+   {
+      long alloc = FLINT_MAX(256, 2*qs_inf->lp_alloc);
+
+      qs_inf->lp_prime = flint_realloc(qs_inf->lp_prime, alloc*sizeof(mp_limb_t));
+      qs_inf->lp_off = flint_realloc(qs_inf->lp_off, alloc*sizeof(long));
+      qs_inf->lp_Y = flint_realloc(qs_inf->lp_Y, alloc*sizeof(fmpz));
+      for (i = qs_inf->lp_alloc; i < alloc; i++)
+         fmpz_init(qs_inf->lp_Y + i);
+      qs_inf->lp_alloc = alloc;
+   }
+
+   if (qs_inf->lp_rel_len + 2*num + 1 > qs_inf->lp_rel_alloc)
+   {
+      qs_inf->lp_rel_alloc = FLINT_MAX(2*qs_inf->lp_rel_alloc, 
+                                       qs_inf->lp_rel_len + 2*num + 1);
+      qs_inf->lp_rel = flint_realloc(qs_inf->lp_rel, 
+                                     qs_inf->lp_rel_alloc*sizeof(long));
+   }
+
+   i = qs_inf->num_partials;
+   qs_inf->lp_prime[i] = L;
+   fmpz_set(qs_inf->lp_Y + i, Y);
+   qs_inf->lp_off[i] = qs_inf->lp_rel_len;
+
+   rel = qs_inf->lp_rel + qs_inf->lp_rel_len;
+   rel[0] = num;
+   for (j = 0; j < num; j++)
+   {
+      rel[2*j + 1] = fac[j].ind;
+      rel[2*j + 2] = fac[j].exp;
+   }
+   qs_inf->lp_rel_len += 2*num + 1;
+
+   qs_inf->lp_hash[h] = i;
+   qs_inf->num_partials++;
+
+   /* keep the hash table at most half full */
+   if (2*qs_inf->num_partials > qs_inf->lp_hash_mask)
+   {
+      qs_inf->lp_hash_mask = 2*qs_inf->lp_hash_mask + 1;
+      qs_inf->lp_hash = flint_realloc(qs_inf->lp_hash, 
+                                (qs_inf->lp_hash_mask + 1)*sizeof(long));
+      for (j = 0; j <= qs_inf->lp_hash_mask; j++)
+         qs_inf->lp_hash[j] = -1;
+
+      for (i = 0; i < qs_inf->num_partials; i++)
+         qs_inf->lp_hash[qsieve_lp_slot(qs_inf, qs_inf->lp_prime[i])] = i;
+   }
+}
+
+/*
+   Add a relation Y^2 = L * prod p_i^e_i mod kn, where the factor base 
+   indices and exponents are given in increasing order of index by fac. 
+   If L = 1 it is inserted into the matrix straight away, otherwise it 
+   is combined with a stored partial relation with the same large prime,
+   if any, or stored.
+*/
+void qsieve_add_relation(qs_t qs_inf, fmpz_t Y, mp_limb_t L, 
+                                                     fac_t * fac, long num)
+{
+   long h, i, j, k, m, num2, * rel;
+   fac_t * comb;
+   fmpz_t Y2, Linv;
+
+   if (L == 1)
+   {
+      qsieve_insert_full(qs_inf, Y, fac, num);
+      return;
+   }
+
+   h = qsieve_lp_slot(qs_inf, L);
+
+   if (qs_inf->lp_hash[h] == -1)
+   {
+      qsieve_store_partial(qs_inf, Y, L, fac, num, h);
+      return;
+   }
+
+   /* merge the factors of the two partial relations, dropping L^2 */
+   i = qs_inf->lp_hash[h];
+   rel = qs_inf->lp_rel + qs_inf->lp_off[i];
+   num2 = rel[0];
+
+   comb = flint_malloc((num + num2)*sizeof(fac_t));
+
+   for (j = k = m = 0; j < num || k < num2; m++)
+   {
+      if (k == num2 || (j < num && fac[j].ind < rel[2*k + 1]))
+      {
+         comb[m] = fac[j];
+         j++;
+      } else if (j == num || rel[2*k + 1] < fac[j].ind)
+      {
+         comb[m].ind = rel[2*k + 1];
+         comb[m].exp = rel[2*k + 2];
+         k++;
+      } else
+      {
+         comb[m].ind = fac[j].ind;
+         comb[m].exp = fac[j].exp + rel[2*k + 2];
+         j++;
+         k++;
+      }
+   }
+
+   fmpz_init(Y2);
+   fmpz_init(Linv);
+
+   /* Y = Y1*Y2/L mod n, unless L is a factor of n */
+   fmpz_set_ui(Linv, L);
+   if (fmpz_invmod(Linv, Linv, qs_inf->n))
+   {
+      fmpz_mul(Y2, Y, qs_inf->lp_Y + i);
+      fmpz_mul(Y2, Y2, Linv);
+      fmpz_mod(Y2, Y2, qs_inf->n);
+
+      qsieve_insert_full(qs_inf, Y2, comb, m);
+      qs_inf->num_combined++;
+   }
+
+   fmpz_clear(Y2);
+   fmpz_clear(Linv);
+   flint_free(comb);
+}
+
+/*
+   Store a relation found by a thread sieving with the given polynomial, 
+   to be added later by qsieve_flush_relations. Only the thread owning
+   poly touches it, so no locking is required.
+*/
+void qsieve_store_relation(qs_poly_t poly, fmpz_t Y, mp_limb_t L, 
+                                                     fac_t * fac, long num)
+{
+   long i, alloc;
+
+   if (num > poly->max_factors) /* too many factors to store */
+      return;
+
+   if (poly->num_rels == poly->rel_alloc)
+   {
+      alloc = FLINT_MAX(16, 2*poly->rel_alloc);
+
+      poly->rel_Y = flint_realloc(poly->rel_Y, alloc*sizeof(fmpz));
+      for (i = poly->rel_alloc; i < alloc; i++)
+         fmpz_init(poly->rel_Y + i);
+      poly->rel_L = flint_realloc(poly->rel_L, alloc*sizeof(mp_limb_t));
+      poly->rel_num = flint_realloc(poly->rel_num, alloc*sizeof(long));
+      poly->rel_fac = flint_realloc(poly->rel_fac, 
+                                    alloc*poly->max_factors*sizeof(fac_t));
+
+      poly->rel_alloc = alloc;
+   }
+
+   i = poly->num_rels;
+   fmpz_set(poly->rel_Y + i, Y);
+   poly->rel_L[i] = L;
+   poly->rel_num[i] = num;
+   memcpy(poly->rel_fac + i*poly->max_factors, fac, num*sizeof(fac_t));
+
+   poly->num_rels++;
+}
+
+/*
+   Add the relations stored for the given polynomial, in the order they
+   were found, and return the number of them
+*/
+long qsieve_flush_relations(qs_t qs_inf, qs_poly_t poly)
+{
+   long i, num = poly->num_rels;
+
+   for (i = 0; i < num; i++)
+      qsieve_add_relation(qs_inf, poly->rel_Y + i, poly->rel_L[i], 
+                          poly->rel_fac + i*poly->max_factors, poly->rel_num[i]);
+
+   poly->num_rels = 0;
+
+   return num;
+}
@@ -0,0 +1,74 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "qsieve.h"
+#include "fmpz.h"
+
+void qsieve_clear(qs_t qs_inf)
+{
+    long i;
+
+    if (qs_inf->poly != NULL)
+    {
+        for (i = 0; i < qs_inf->num_threads; i++)
+            qsieve_poly_clear(qs_inf->poly + i);
+        flint_free(qs_inf->poly);
+    }
+
+    for (i = 0; i < qs_inf->num_A_used; i++)
+        fmpz_clear(qs_inf->A_used + i);
+    flint_free(qs_inf->A_used);
+
+    for (i = 0; i < qs_inf->lp_alloc; i++)
+        fmpz_clear(qs_inf->lp_Y + i);
+    flint_free(qs_inf->lp_Y);
+    flint_free(qs_inf->lp_prime);
+    flint_free(qs_inf->lp_off);
+    flint_free(qs_inf->lp_rel);
+    flint_free(qs_inf->lp_hash);
+
+    fmpz_clear(qs_inf->target_A_mp);
+    flint_randclear(qs_inf->state);
+
+    qs_inf->poly     = NULL;
+    qs_inf->A_used   = NULL;
+    qs_inf->lp_prime = NULL;
+    qs_inf->lp_Y     = NULL;
+    qs_inf->lp_off   = NULL;
+    qs_inf->lp_rel   = NULL;
+    qs_inf->lp_hash  = NULL;
+
+    qs_inf->num_A_used = 0;
+    qs_inf->A_used_alloc = 0;
+    qs_inf->num_partials = 0;
+    qs_inf->lp_alloc = 0;
+    qs_inf->lp_rel_len = 0;
+    qs_inf->lp_rel_alloc = 0;
+
+    qsieve_ll_clear(qs_inf);
+}
@@ -0,0 +1,352 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#undef ulong /* avoid clash with stdlib */
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#define ulong unsigned long 
+
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "qsieve.h"
+#include "thread_pool.h"
+#include "fmpz.h"
+
+/*
+   Sieve the block [start, start + len) of the sieve interval, which must
+   be the block following the last one sieved for this polynomial.
+*/
+void qsieve_do_sieving(qs_t qs_inf, qs_poly_t poly, 
+                                   unsigned char * sieve, long start, long len)
+{
+   long num_primes = qs_inf->num_primes;
+   prime_t * factor_base = qs_inf->factor_base;
+   long * posn1 = poly->posn1;
+   long * posn2 = poly->posn2;
+   long end = start + len;
+   unsigned char * block = sieve - start;
+   register long pos, p;
+   char size;
+   long pind;
+   
+   memset(sieve, 0, len + sizeof(ulong));
+   
+   for (pind = qs_inf->small_primes; pind < num_primes; pind++) 
+   {
+      if (poly->soln1[pind] == (mp_limb_t) -1) /* don't sieve with A factors */
+         continue;
+
+      p = factor_base[pind].p;
+      size = factor_base[pind].size;
+
+      for (pos = posn1[pind]; pos < end; pos += p)
+         block[pos] += size;
+      posn1[pind] = pos;
+
+      for (pos = posn2[pind]; pos < end; pos += p)
+         block[pos] += size;
+      posn2[pind] = pos;
+   }
+}
+
+/*
+   Trial divide the value of the polynomial at the given index of the 
+   sieve interval. If it gives a full or partial relation, store it with
+   the polynomial until it is added by qsieve_flush_relations and 
+   return 1, otherwise return 0.
+*/
+int qsieve_evaluate_candidate(qs_t qs_inf, qs_poly_t poly, long i)
+{
+   long num_primes = qs_inf->num_primes;
+   prime_t * factor_base = qs_inf->factor_base;
+   mp_limb_t * soln1 = poly->soln1;
+   mp_limb_t * soln2 = poly->soln2;
+   long * A_ind = poly->A_ind;
+   fac_t * factor = poly->factor;
+   long max_factors = qs_inf->max_factors;
+   long num_factors = 0;
+   long j, k, exp, sign;
+   mp_limb_t p, pinv, modp, L;
+   int ret = 0;
+   fmpz_t X, Y, res;
+
+   fmpz_init(X); 
+   fmpz_init(Y); 
+   fmpz_init(res); 
+    
+   fmpz_set_si(X, i - qs_inf->sieve_size/2); /* X */
+
+   fmpz_mul(Y, X, poly->A);
+   fmpz_add(Y, Y, poly->B); /* Y = AX + B */
+   fmpz_add(res, Y, poly->B);
+   fmpz_mul(res, res, X);  
+   fmpz_add(res, res, poly->C); /* res = AX^2 + 2BX + C */
+
+   sign = (fmpz_sgn(res) < 0);
+   fmpz_abs(res, res);
+
+   /* divide out powers of the multiplier, 2 and the sign */
+   exp = 0;
+   if (factor_base[0].p != 1)
+   {
+      p = factor_base[0].p;
+      while (fmpz_fdiv_ui(res, p) == 0)
+      {
+         fmpz_divexact_ui(res, res, p);
+         exp++;
+      }
+   }
+   if (exp)
+   {
+      factor[num_factors].ind = 0;
+      factor[num_factors++].exp = exp;
+   }
+
+   exp = fmpz_val2(res);
+   if (exp)
+   {
+      fmpz_tdiv_q_2exp(res, res, exp);
+      factor[num_factors].ind = 1;
+      factor[num_factors++].exp = exp;
+   }
+   
+   if (sign)
+   {
+      factor[num_factors].ind = 2;
+      factor[num_factors++].exp = 1;
+   }
+
+   /* pull out factor base primes, and the factors of A */
+   for (j = 3, k = 0; j < num_primes && !fmpz_is_one(res); j++) 
+   {
+      p = factor_base[j].p;
+      
+      if (soln1[j] == (mp_limb_t) -1)
+      {
+         exp = 1;
+         k++;
+      } else
+      {
+         pinv = factor_base[j].pinv;
+         modp = n_mod2_preinv(i, p, pinv);
+         if (modp != soln1[j] && modp != soln2[j])
+            continue;
+         exp = 0;
+      }
+
+      while (fmpz_fdiv_ui(res, p) == 0)
+      {
+         fmpz_divexact_ui(res, res, p);
+         exp++;
+      }
+
+      if (exp)
+      {
+         if (num_factors == max_factors)
+            goto cleanup;
+
+         factor[num_factors].ind = j;
+         factor[num_factors++].exp = exp;
+      }
+   }
+
+   /* commit any outstanding A factors */
+   for ( ; k < qs_inf->s; k++)
+   {
+      if (A_ind[k] >= j)
+      {
+         if (num_factors == max_factors)
+            goto cleanup;
+
+         factor[num_factors].ind = A_ind[k];
+         factor[num_factors++].exp = 1; 
+      }
+   }
+
+   /* full relation, or partial relation with a single large prime */
+   if (fmpz_is_one(res))
+      L = 1;
+   else if (fmpz_size(res) == 1 && fmpz_get_ui(res) < qs_inf->large_prime)
+      L = fmpz_get_ui(res);
+   else
+      goto cleanup;
+
+#if (QS_DEBUG & 8)
+   printf("relation with large prime %lu: ", L);
+   for (j = 0; j < num_factors; j++)
+      printf("%d^%ld ", factor_base[factor[j].ind].p, factor[j].exp);
+   printf("\n");
+#endif
+
+   qsieve_store_relation(poly, Y, L, factor, num_factors);
+   ret = 1;
+
+cleanup:
+   fmpz_clear(X);
+   fmpz_clear(Y);
+   fmpz_clear(res);
+      
+   return ret;
+}
+
+/* 
+   Look for candidates in the block [start, start + len) of the sieve
+   interval, returning the number of full or partial relations found
+*/
+long qsieve_evaluate_sieve(qs_t qs_inf, qs_poly_t poly, 
+                                   unsigned char * sieve, long start, long len)
+{
+   long i, j;
+   ulong * sieve2 = (ulong *) sieve;
+   unsigned char thresh = qs_inf->sieve_thresh;
+   ulong mask;
+   long rels = 0;
+
+   /* 
+      a byte exceeding thresh has a bit set at least as high as the top 
+      bit of thresh + 1, so whole words without such bits can be skipped
+   */
+   mask = (0xFFUL << (FLINT_BIT_COUNT(thresh + 1UL) - 1)) & 0xFFUL;
+   mask *= (~0UL)/0xFFUL;
+
+   for (j = 0; j < (len + sizeof(ulong) - 1)/sizeof(ulong); j++)
+   {
+      if ((sieve2[j] & mask) == 0)
+         continue;
+
+      for (i = j*sizeof(ulong); i < (j + 1)*sizeof(ulong) && i < len; i++)
+      {
+         if (sieve[i] > thresh)
+            rels += qsieve_evaluate_candidate(qs_inf, poly, start + i);
+      }
+   }
+
+   return rels;
+}
+
+/*
+   Sieve the interval of the current polynomial in blocks of CACHE_SIZE
+   bytes, returning the number of full or partial relations found
+*/
+long qsieve_sieve_poly(qs_t qs_inf, qs_poly_t poly, unsigned char * sieve)
+{
+   long i, start, len;
+   long rels = 0;
+
+   for (i = qs_inf->small_primes; i < qs_inf->num_primes; i++)
+   {
+      poly->posn1[i] = poly->soln1[i];
+      poly->posn2[i] = poly->soln2[i];
+   }
+
+   for (start = 0; start < qs_inf->sieve_size; start += CACHE_SIZE)
+   {
+      len = FLINT_MIN(CACHE_SIZE, qs_inf->sieve_size - start);
+
+      qsieve_do_sieving(qs_inf, poly, sieve, start, len);
+      rels += qsieve_evaluate_sieve(qs_inf, poly, sieve, start, len);
+   }
+
+   return rels;
+}
+
+/*
+   Choose the factor base primes for the polynomials B with the given 
+   A coefficient and sieve all 2^(s-1) of them, storing the relations
+   found with the polynomial. Reads but does not modify qs_inf, so that 
+   several threads can do this at once with different poly and sieve.
+*/
+long qsieve_sieve_A(qs_t qs_inf, qs_poly_t poly, unsigned char * sieve)
+{
+   long s = qs_inf->s;
+   long relations = 0;
+   long poly_index;
+   
+   qsieve_compute_poly_data(qs_inf, poly);
+   
+   for (poly_index = 0; poly_index < (1L << (s - 1)); poly_index++)
+   {
+      if (poly_index != 0)
+         qsieve_next_poly(qs_inf, poly, poly_index);
+
+#if (QS_DEBUG & 4)
+      fmpz_print(poly->A); printf("X^2+2*"); fmpz_print(poly->B); 
+      printf("X+"); fmpz_print(poly->C); printf("\n");
+#endif
+      
+      relations += qsieve_sieve_poly(qs_inf, poly, sieve);
+   }
+
+   return relations;
+}
+
+typedef struct
+{
+   qs_s * qs_inf;
+   unsigned char * sieve;
+} qsieve_collect_arg_t;
+
+static void
+_qsieve_collect_worker(void * arg_ptr, long i)
+{
+   qsieve_collect_arg_t * arg = (qsieve_collect_arg_t *) arg_ptr;
+   
+   qsieve_sieve_A(arg->qs_inf, arg->qs_inf->poly + i, 
+                                  arg->sieve + i*(CACHE_SIZE + sizeof(ulong)));
+}
+
+/*
+   Sieve with a new A coefficient for each of the qs_inf->num_threads 
+   polynomials, in parallel, where sieve has room for a block of
+   CACHE_SIZE + sizeof(ulong) bytes per polynomial. The relations each 
+   thread found are then added in a fixed order, so the result does not 
+   depend on the number of threads actually used. Returns the number of 
+   full and partial relations found.
+*/
+long qsieve_collect_relations(qs_t qs_inf, unsigned char * sieve)
+{
+   long i, num = qs_inf->num_threads;
+   long relations = 0;
+   qsieve_collect_arg_t arg;
+   
+   /* the choice of A uses the random state and the list of used A's */
+   for (i = 0; i < num; i++)
+      qsieve_compute_A(qs_inf, qs_inf->poly + i);
+
+   arg.qs_inf = qs_inf;
+   arg.sieve = sieve;
+
+   if (num == 1)
+      _qsieve_collect_worker(&arg, 0);
+   else
+      flint_parallel_do(_qsieve_collect_worker, &arg, num, num);
+
+   for (i = 0; i < num; i++)
+      relations += qsieve_flush_relations(qs_inf, qs_inf->poly + i);
+
+   return relations;
+}
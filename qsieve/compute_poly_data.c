@@ -0,0 +1,276 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#undef ulong /* avoid clash with stdlib */
+#include <stdlib.h>
+#include <stdio.h>
+#define ulong unsigned long
+
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "qsieve.h"
+#include "fmpz.h"
+
+/* 
+   Find the factor base prime, at index at least small_primes, whose 
+   value is closest to r, but which is not one of the first num indices 
+   in A_ind. Returns -1 if there is none within the factor base.
+*/
+static long 
+qsieve_closest_prime(qs_t qs_inf, mp_limb_t r, long * A_ind, long num)
+{
+    prime_t * factor_base = qs_inf->factor_base;
+    long lo = qs_inf->small_primes, hi = qs_inf->num_primes - 1, mid, d, i, j;
+
+    if (r < factor_base[lo].p || r > factor_base[hi].p)
+        return -1;
+
+    while (lo < hi) /* find first prime >= r */
+    {
+        mid = (lo + hi)/2;
+        if (factor_base[mid].p < r)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    /* move outwards until we find an index which is not in A_ind */
+    for (d = 0; d < 2*num + 2; d++)
+    {
+        i = (d & 1) ? lo + d/2 : lo - 1 - d/2;
+
+        if (i < qs_inf->small_primes || i >= qs_inf->num_primes)
+            continue;
+
+        for (j = 0; j < num && A_ind[j] != i; j++) ;
+        
+        if (j == num)
+            return i;
+    }
+
+    return -1;
+}
+
+void qsieve_compute_A(qs_t qs_inf, qs_poly_t poly)
+{
+    long s = qs_inf->s;
+    long * A_ind = poly->A_ind;
+    prime_t * factor_base = qs_inf->factor_base;
+    long i, j, tries;
+    fmpz_t rem;
+
+    fmpz_init(rem);
+
+    for (tries = 1; ; tries++)
+    {
+        /* widen the range of factors if we are struggling to find new A's */
+        if (tries % 100 == 0)
+        {
+            qs_inf->min = FLINT_MAX(qs_inf->min - qs_inf->span/4, qs_inf->small_primes);
+            qs_inf->span = FLINT_MIN(qs_inf->span + qs_inf->span/2, 
+                                     qs_inf->num_primes - qs_inf->min);
+        }
+
+        /* choose s - 1 distinct factors at random */
+        fmpz_one(poly->A);
+        for (i = 0; i < s - 1; i++)
+        {
+            do
+            {
+                A_ind[i] = qs_inf->min + n_randint(qs_inf->state, qs_inf->span);
+                for (j = 0; j < i && A_ind[j] != A_ind[i]; j++) ;
+            } while (j < i);
+
+            fmpz_mul_ui(poly->A, poly->A, factor_base[A_ind[i]].p);
+        }
+
+        /* choose the final factor to bring A as close as possible to target */
+        fmpz_tdiv_q(rem, qs_inf->target_A_mp, poly->A);
+        if (fmpz_size(rem) > 1)
+            continue;
+
+        A_ind[s - 1] = qsieve_closest_prime(qs_inf, fmpz_get_ui(rem), A_ind, s - 1);
+        if (A_ind[s - 1] == -1)
+            continue;
+
+        fmpz_mul_ui(poly->A, poly->A, factor_base[A_ind[s - 1]].p);
+
+        /* don't use the same A twice */
+        for (i = 0; i < qs_inf->num_A_used; i++)
+            if (fmpz_equal(qs_inf->A_used + i, poly->A))
+                break;
+
+        if (i == qs_inf->num_A_used)
+            break;
+    }
+
+    if (qs_inf->num_A_used == qs_inf->A_used_alloc)
+    {
+        qs_inf->A_used_alloc = FLINT_MAX(16, 2*qs_inf->A_used_alloc);
+        qs_inf->A_used = flint_realloc(qs_inf->A_used, 
+                                        qs_inf->A_used_alloc*sizeof(fmpz));
+    }
+    fmpz_init_set(qs_inf->A_used + qs_inf->num_A_used, poly->A);
+    qs_inf->num_A_used++;
+
+    /* sort the factors of A by index */
+    for (i = 1; i < s; i++)
+    {
+        long t = A_ind[i];
+        for (j = i; j > 0 && A_ind[j - 1] > t; j--)
+            A_ind[j] = A_ind[j - 1];
+        A_ind[j] = t;
+    }
+
+#if (QS_DEBUG & 2)
+    printf("A = "); fmpz_print(poly->A); printf(", target A = ");
+    fmpz_print(qs_inf->target_A_mp); printf("\n");
+#endif
+
+    fmpz_clear(rem);
+}
+
+void qsieve_compute_C(qs_t qs_inf, qs_poly_t poly)
+{
+    fmpz_mul(poly->C, poly->B, poly->B);
+    fmpz_sub(poly->C, poly->C, qs_inf->kn);
+    fmpz_divexact(poly->C, poly->C, poly->A);
+}
+
+void qsieve_compute_poly_data(qs_t qs_inf, qs_poly_t poly)
+{
+    long s = qs_inf->s;
+    long num_primes = qs_inf->num_primes;
+    long * A_ind = poly->A_ind;
+    fmpz * B_terms = poly->B_terms;
+    mp_limb_t * A_inv = poly->A_inv;
+    mp_limb_t ** A_inv2B = poly->A_inv2B;
+    mp_limb_t * soln1 = poly->soln1;
+    mp_limb_t * soln2 = poly->soln2;
+    prime_t * factor_base = qs_inf->factor_base;
+    int * sqrts = qs_inf->sqrts;
+    mp_limb_t p, pinv, temp, M = qs_inf->sieve_size/2;
+    long i, j;
+    fmpz_t A_p;
+
+    fmpz_init(A_p);
+
+    /* compute B_terms and B */
+    fmpz_zero(poly->B);
+    for (j = 0; j < s; j++)
+    {
+        p = factor_base[A_ind[j]].p;
+        pinv = factor_base[A_ind[j]].pinv;
+
+        fmpz_divexact_ui(A_p, poly->A, p);
+        temp = n_invmod(fmpz_fdiv_ui(A_p, p), p);
+        temp = n_mulmod2_preinv(temp, sqrts[A_ind[j]], p, pinv);
+        if (temp > p/2) 
+            temp = p - temp;
+
+        fmpz_mul_ui(B_terms + j, A_p, temp);
+        fmpz_add(poly->B, poly->B, B_terms + j);
+    }
+
+    /* compute roots of the polynomial modulo the factor base primes */
+    for (i = 3; i < num_primes; i++)
+    {
+        p = factor_base[i].p;
+        pinv = factor_base[i].pinv;
+
+        temp = fmpz_fdiv_ui(poly->A, p);
+        if (temp == 0) /* p is a factor of A */
+        {
+            soln1[i] = soln2[i] = -1;
+            continue;
+        }
+
+        A_inv[i] = n_invmod(temp, p);
+
+        for (j = 0; j < s; j++)
+        {
+            temp = fmpz_fdiv_ui(B_terms + j, p);
+            temp = n_mulmod2_preinv(temp, A_inv[i], p, pinv);
+            temp = n_addmod(temp, temp, p);
+            A_inv2B[j][i] = temp;
+        }
+
+        temp = fmpz_fdiv_ui(poly->B, p);
+        temp = n_submod(sqrts[i], temp, p);
+        temp = n_mulmod2_preinv(temp, A_inv[i], p, pinv);
+        soln1[i] = n_addmod(temp, n_mod2_preinv(M, p, pinv), p);
+
+        temp = n_mulmod2_preinv(sqrts[i], A_inv[i], p, pinv);
+        temp = n_addmod(temp, temp, p);
+        soln2[i] = n_submod(soln1[i], temp, p);
+    }
+
+    qsieve_compute_C(qs_inf, poly);
+
+    fmpz_clear(A_p);
+}
+
+void qsieve_next_poly(qs_t qs_inf, qs_poly_t poly, long poly_index)
+{
+    long num_primes = qs_inf->num_primes;
+    mp_limb_t * soln1 = poly->soln1;
+    mp_limb_t * soln2 = poly->soln2;
+    prime_t * factor_base = qs_inf->factor_base;
+    mp_limb_t p, correction;
+    mp_limb_t * poly_corr;
+    int poly_add;
+    long i, j;
+
+    /* Gray code: the next B differs from the last in one B_term */
+    for (j = 0; j < qs_inf->s; j++)
+        if (((poly_index >> j) & 1UL) != 0UL) break;
+
+    poly_add = ((poly_index >> j) & 2);
+    poly_corr = poly->A_inv2B[j];
+
+    for (i = 3; i < num_primes; i++) 
+    {
+        if (soln1[i] == (mp_limb_t) -1) 
+            continue;
+
+        p = factor_base[i].p;
+        correction = (poly_add ? p - poly_corr[i] : poly_corr[i]);
+        soln1[i] = n_addmod(soln1[i], correction, p);
+        soln2[i] = n_addmod(soln2[i], correction, p);
+    }
+
+    if (poly_add)
+    {
+        fmpz_add(poly->B, poly->B, poly->B_terms + j);
+        fmpz_add(poly->B, poly->B, poly->B_terms + j);
+    } else
+    {
+        fmpz_sub(poly->B, poly->B, poly->B_terms + j);
+        fmpz_sub(poly->B, poly->B, poly->B_terms + j);
+    }
+
+    qsieve_compute_C(qs_inf, poly);
+}
@@ -0,0 +1,95 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "qsieve.h"
+#include "fmpz.h"
+
+void qsieve_init(qs_t qs_inf, const fmpz_t n)
+{
+    ulong i;
+
+    /* store n in struct */
+    fmpz_init_set(qs_inf->n, n);
+    qs_inf->hi = 0;
+    qs_inf->lo = 0;
+
+    /* determine the number of bits of n */
+    qs_inf->bits = fmpz_bits(n);
+
+    /* determine which index in the tuning table n corresponds to */
+    for (i = 1; i < QS_TUNE_SIZE; i++)
+    {
+        if (qsieve_tune[i][0] > qs_inf->bits)
+            break;
+    }
+    i--;
+
+    qs_inf->ks_primes  = qsieve_tune[i][1]; /* number of Knuth-Schroeppel primes */
+    qs_inf->num_primes = qsieve_tune[i][2]; /* number of factor base primes */
+
+    fmpz_init(qs_inf->kn); /* initialise kn */
+    fmpz_init(qs_inf->C); /* unused by qsieve_factor */
+    fmpz_init(qs_inf->target_A_mp);
+
+    qs_inf->factor_base = NULL;
+    qs_inf->sqrts       = NULL;
+    qs_inf->B_terms     = NULL;
+    qs_inf->A_inv       = NULL;
+    qs_inf->A_inv2B     = NULL;
+    qs_inf->small       = NULL;
+    qs_inf->factor      = NULL;
+    qs_inf->matrix      = NULL;
+    qs_inf->Y_arr       = NULL;
+    qs_inf->relation    = NULL;
+    qs_inf->qsort_arr   = NULL;
+    qs_inf->prime_count = NULL;
+    qs_inf->poly        = NULL;
+    qs_inf->A_used      = NULL;
+    qs_inf->lp_prime    = NULL;
+    qs_inf->lp_Y        = NULL;
+    qs_inf->lp_off      = NULL;
+    qs_inf->lp_rel      = NULL;
+    qs_inf->lp_hash     = NULL;
+
+    qs_inf->A = 0;
+    qs_inf->num_threads = 0;
+    qs_inf->num_A_used = 0;
+    qs_inf->A_used_alloc = 0;
+    qs_inf->num_partials = 0;
+    qs_inf->lp_alloc = 0;
+    qs_inf->lp_rel_len = 0;
+    qs_inf->lp_rel_alloc = 0;
+    qs_inf->lp_hash_mask = -1;
+    qs_inf->num_combined = 0;
+
+    flint_randinit(qs_inf->state);
+
+#if (QS_DEBUG & 16)
+    qs_inf->sieve_tally = flint_malloc(256*sizeof(long));
+#endif
+}
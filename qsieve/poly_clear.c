@@ -0,0 +1,52 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "qsieve.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+void qsieve_poly_clear(qs_poly_t poly)
+{
+   fmpz_clear(poly->A);
+   fmpz_clear(poly->B);
+   fmpz_clear(poly->C);
+
+   flint_free(poly->A_ind);
+   _fmpz_vec_clear(poly->B_terms, poly->s);
+
+   flint_free(poly->A_inv);
+   flint_free(poly->posn1);
+   flint_free(poly->A_inv2B[0]);
+   flint_free(poly->A_inv2B);
+   flint_free(poly->factor);
+
+   _fmpz_vec_clear(poly->rel_Y, poly->rel_alloc);
+   flint_free(poly->rel_L);
+   flint_free(poly->rel_fac);
+   flint_free(poly->rel_num);
+}
@@ -0,0 +1,68 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "qsieve.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+void qsieve_poly_init(qs_poly_t poly, qs_t qs_inf)
+{
+   long num_primes = qs_inf->num_primes;
+   long s = qs_inf->s; /* number of prime factors in A coeff */
+   long i; 
+
+   fmpz_init(poly->A);
+   fmpz_init(poly->B);
+   fmpz_init(poly->C);
+
+   poly->s = s;
+   poly->A_ind = flint_malloc(s*sizeof(long));
+   poly->B_terms = _fmpz_vec_init(s);
+
+   poly->A_inv = flint_malloc(3*num_primes*sizeof(mp_limb_t));  
+   poly->soln1 = poly->A_inv + num_primes; 
+   poly->soln2 = poly->soln1 + num_primes; 
+
+   poly->posn1 = flint_malloc(2*num_primes*sizeof(long));
+   poly->posn2 = poly->posn1 + num_primes;
+
+   poly->A_inv2B = flint_malloc(s*sizeof(mp_limb_t *));
+   poly->A_inv2B[0] = flint_malloc(num_primes*s*sizeof(mp_limb_t));
+   for (i = 1; i < s; i++)
+      poly->A_inv2B[i] = poly->A_inv2B[i - 1] + num_primes;
+
+   poly->factor = flint_malloc(qs_inf->max_factors*sizeof(fac_t));
+
+   poly->max_factors = qs_inf->max_factors;
+   poly->rel_Y = NULL;
+   poly->rel_L = NULL;
+   poly->rel_fac = NULL;
+   poly->rel_num = NULL;
+   poly->num_rels = 0;
+   poly->rel_alloc = 0;
+}
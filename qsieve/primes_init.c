@@ -0,0 +1,197 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#undef ulong /* avoid clash with stdlib */
+#include <stdio.h>
+#define ulong unsigned long 
+
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "qsieve.h"
+#include "fmpz.h"
+
+/*
+   Extend the factor base to num_primes entries, returning a prime factor 
+   of n if one is found. Entries 0, 1 and 2 are reserved for k, 2 and the
+   sign of a relation.
+*/
+static mp_limb_t 
+qsieve_compute_factor_base(qs_t qs_inf, long num_primes)
+{
+    mp_limb_t p, nmod;
+    mp_limb_t pinv;
+    mp_limb_t k = qs_inf->k;
+    long num = qs_inf->num_primes;
+    long fb_prime;
+    prime_t * factor_base;
+    int * sqrts;
+    
+    factor_base = flint_realloc(qs_inf->factor_base, num_primes*sizeof(prime_t));
+    qs_inf->factor_base = factor_base;
+    
+    sqrts = flint_realloc(qs_inf->sqrts, sizeof(int)*num_primes);
+    qs_inf->sqrts = sqrts;
+
+    if (num == 0)
+    {
+        p = 2;
+        num = 3;
+    } else
+        p = factor_base[num - 1].p;
+
+    for (fb_prime = num; fb_prime < num_primes; )
+    {
+        p = n_nextprime(p, 0);
+        pinv = n_preinvert_limb(p);
+        nmod = fmpz_fdiv_ui(qs_inf->n, p); /* n mod p */
+        if (nmod == 0) 
+            return p;
+        
+        nmod = n_mulmod2_preinv(nmod, k, p, pinv); /* kn mod p */
+        if (nmod == 0) /* don't sieve with factors of multiplier */
+            continue;
+        
+        if (n_jacobi_unsigned(nmod, p) == 1) /* kn is a square mod p */
+        {
+            factor_base[fb_prime].p = p;
+            factor_base[fb_prime].pinv = pinv;
+            factor_base[fb_prime].size = FLINT_BIT_COUNT(p);
+            sqrts[fb_prime] = n_sqrtmod(nmod, p);
+            fb_prime++;
+        }   
+    }
+
+    qs_inf->num_primes = num_primes;
+
+    return 0;
+}
+
+mp_limb_t qsieve_primes_init(qs_t qs_inf)
+{
+    long num_primes;
+    long i, s, fact, span;
+    mp_limb_t k = qs_inf->k;
+    mp_limb_t small_factor, p_max;
+    prime_t * factor_base;
+    fmpz_t temp;
+    
+    /* determine which index in the tuning table n corresponds to */
+    for (i = 1; i < QS_TUNE_SIZE; i++)
+    {
+        if (qsieve_tune[i][0] > qs_inf->bits)
+            break;
+    }
+    i--;
+    
+    qs_inf->sieve_size = qsieve_tune[i][4]; /* size of sieve to use */
+    qs_inf->small_primes = qsieve_tune[i][3]; /* number of primes to not sieve with */
+    num_primes = qsieve_tune[i][2]; /* number of factor base primes */
+    qs_inf->qsort_rels = qsieve_tune[i][1]; /* number of relations to accumulate before sorting */
+    
+    qs_inf->num_primes = 0; /* start with 0 primes */
+    small_factor = qsieve_compute_factor_base(qs_inf, num_primes);
+    if (small_factor)
+        return small_factor;
+
+    fmpz_init(temp);
+
+    /* target A = sqrt(2kn)/M */
+    fmpz_mul_2exp(temp, qs_inf->kn, 1);
+    fmpz_sqrt(temp, temp);
+    fmpz_tdiv_q_ui(qs_inf->target_A_mp, temp, qs_inf->sieve_size/2);
+   
+    /* 
+       choose the number s of prime factors of A so that they have about
+       QS_A_PRIME_BITS bits, then find the factor base primes of about 
+       the right size, extending the factor base if they are too large
+    */
+    s = (fmpz_bits(qs_inf->target_A_mp) + QS_A_PRIME_BITS/2)/QS_A_PRIME_BITS;
+    if (s < 2) 
+        s = 2;
+
+    fmpz_root(temp, qs_inf->target_A_mp, s);
+
+    span = FLINT_MAX(6*s, 40);
+
+    while (1)
+    {
+        factor_base = qs_inf->factor_base;
+
+        for (fact = qs_inf->small_primes; fact < qs_inf->num_primes; fact++)
+            if (fmpz_cmp_ui(temp, factor_base[fact].p) <= 0)
+                break;
+
+        if (fact + span/2 < qs_inf->num_primes)
+            break;
+
+        num_primes = (long) (1.2 * (double) qs_inf->num_primes);
+        small_factor = qsieve_compute_factor_base(qs_inf, num_primes);
+        if (small_factor)
+        {
+            fmpz_clear(temp);
+            return small_factor;
+        }
+    }
+
+    qs_inf->s = s;
+    qs_inf->min = FLINT_MAX(fact - span/2, qs_inf->small_primes);
+    qs_inf->span = FLINT_MIN(span, qs_inf->num_primes - qs_inf->min);
+    qs_inf->fact = fact;
+
+    /* consider k, 2 and -1 as factor base primes */
+    factor_base[0].p = k;
+    factor_base[0].pinv = n_preinvert_limb(k);
+    factor_base[0].size = FLINT_BIT_COUNT(k);
+    factor_base[1].p = 2;
+    factor_base[1].size = 2;
+    factor_base[2].p = 1;
+    factor_base[2].size = 0;
+
+    /* partial relations may have one prime above the factor base */
+    p_max = factor_base[qs_inf->num_primes - 1].p;
+    qs_inf->large_prime = p_max*FLINT_MIN(QS_LARGE_PRIME_MULT, p_max);
+
+    /* 
+       values of the polynomials are at most M*sqrt(kn/2), and a candidate 
+       must have most of its bits accounted for by the sieve
+    */
+    fmpz_fdiv_q_2exp(temp, qs_inf->kn, 1);
+    fmpz_sqrt(temp, temp);
+    fmpz_mul_ui(temp, temp, qs_inf->sieve_size/2);
+    i = fmpz_bits(temp) - FLINT_BIT_COUNT(qs_inf->large_prime) - QS_THRESH_ADJUST;
+    qs_inf->sieve_thresh = FLINT_MAX(FLINT_MIN(i, 255), 1);
+
+    fmpz_clear(temp);
+
+#if (QS_DEBUG & 2)
+    printf("Using %ld factor base primes\n", qs_inf->num_primes);
+    printf("min = FB[%ld], span = %ld, number of A factors = %ld, target A = ", 
+           qs_inf->min, qs_inf->span, s);
+    fmpz_print(qs_inf->target_A_mp); printf("\n");
+#endif
+
+    return 0;
+}
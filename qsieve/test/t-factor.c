@@ -0,0 +1,99 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "qsieve.h"
+
+int main(void)
+{
+   int i, j;
+   flint_rand_t state;
+   fmpz_t n, p, q, f;
+
+   printf("factor....");
+   fflush(stdout);
+ 
+   flint_randinit(state);
+
+   fmpz_init(n);
+   fmpz_init(p);
+   fmpz_init(q);
+   fmpz_init(f);
+
+   for (i = 0; i < 20; i++) /* Test n = p*q with 90 to 150 bits */
+   {
+      mp_bitcnt_t bits = 90 + n_randint(state, 61);
+
+      /* relations are collected by one or more threads */
+      flint_set_num_threads(n_randint(state, 4) + 1);
+
+      for (j = 0; j < 2; j++)
+      {
+         mp_bitcnt_t b = (j == 0) ? bits/2 - n_randint(state, bits/6) 
+                                  : bits - fmpz_bits(p);
+
+         fmpz_randbits(f, state, b);
+         fmpz_abs(f, f);
+         fmpz_setbit(f, b - 1);
+         if (fmpz_is_even(f))
+            fmpz_add_ui(f, f, 1);
+         while (!fmpz_is_probabprime(f))
+            fmpz_add_ui(f, f, 2);
+
+         fmpz_swap(j == 0 ? p : q, f);
+      }
+
+      if (fmpz_equal(p, q))
+         continue;
+
+      fmpz_mul(n, p, q);
+
+      if (!qsieve_factor(f, n) || fmpz_is_one(f) || fmpz_equal(f, n)
+          || !fmpz_divisible(n, f))
+      {
+         printf("FAIL:\n");
+         printf("n = "); fmpz_print(n); printf("\n");
+         printf("f = "); fmpz_print(f); printf("\n");
+         abort();
+      }
+   }
+
+   flint_set_num_threads(1);
+
+   fmpz_clear(n);
+   fmpz_clear(p);
+   fmpz_clear(q);
+   fmpz_clear(f);
+   
+   flint_randclear(state);
+   _fmpz_cleanup();
+   printf("PASS\n");
+   return 0;
+}
@@ -0,0 +1,130 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "thread_pool.h"
+
+typedef struct
+{
+    mp_limb_t * res;
+    long n;
+    int nested;
+} work_t;
+
+static void square_worker(void * varg, long i)
+{
+    work_t * arg = (work_t *) varg;
+    
+    arg->res[i] += (mp_limb_t) i * i;
+}
+
+static void nested_worker(void * varg, long i)
+{
+    work_t * arg = (work_t *) varg;
+    work_t inner;
+    
+    inner.res = arg->res + i*arg->n;
+    inner.n = arg->n;
+
+    flint_parallel_do(square_worker, &inner, arg->n, flint_get_num_threads());
+}
+
+int main(void)
+{
+    int i;
+    long j, k;
+    flint_rand_t state;
+    flint_randinit(state);
+
+    printf("parallel_do....");
+    fflush(stdout);
+
+    for (i = 0; i < 2000; i++)
+    {
+        work_t arg;
+        long n = n_randint(state, 300);
+
+        flint_set_num_threads(n_randint(state, 9) + 1);
+
+        arg.n = n;
+        arg.res = flint_calloc(n + 1, sizeof(mp_limb_t));
+
+        flint_parallel_do(square_worker, &arg, n, n_randint(state, 10) + 1);
+
+        for (j = 0; j < n; j++)
+        {
+            if (arg.res[j] != (mp_limb_t) j*j)
+            {
+                printf("FAIL:\n");
+                printf("n = %ld, num_threads = %d, j = %ld, res = %lu\n", 
+                    n, flint_get_num_threads(), j, arg.res[j]);
+                abort();
+            }
+        }
+
+        flint_free(arg.res);
+    }
+
+    /* nested parallelism */
+    for (i = 0; i < 200; i++)
+    {
+        work_t arg;
+        long n = n_randint(state, 50);
+
+        flint_set_num_threads(n_randint(state, 9) + 1);
+
+        arg.n = n;
+        arg.res = flint_calloc(n*n + 1, sizeof(mp_limb_t));
+
+        flint_parallel_do(nested_worker, &arg, n, flint_get_num_threads());
+
+        for (j = 0; j < n; j++)
+        {
+            for (k = 0; k < n; k++)
+            {
+                if (arg.res[j*n + k] != (mp_limb_t) k*k)
+                {
+                    printf("FAIL (nested):\n");
+                    printf("n = %ld, num_threads = %d, j = %ld, k = %ld\n", 
+                        n, flint_get_num_threads(), j, k);
+                    abort();
+                }
+            }
+        }
+
+        flint_free(arg.res);
+    }
+
+    flint_set_num_threads(1);
+
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
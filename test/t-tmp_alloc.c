@@ -0,0 +1,146 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+static long num_allocs = 0;
+
+static void * counting_malloc(size_t size)
+{
+    num_allocs++;
+    return malloc(size);
+}
+
+/*
+   Fill a stack of nested temporary blocks with values depending on the
+   depth and check nothing got overwritten by deeper levels
+*/
+static void nested_alloc(flint_rand_t state, long depth)
+{
+    mp_ptr a, b;
+    long i, n1, n2;
+    TMP_INIT;
+
+    if (depth == 0)
+        return;
+
+    n1 = n_randint(state, 20000);
+    n2 = n_randint(state, 20000);
+
+    TMP_START;
+
+    a = TMP_ALLOC(n1*sizeof(mp_limb_t));
+    for (i = 0; i < n1; i++)
+        a[i] = depth + i;
+
+    nested_alloc(state, depth - 1);
+
+    b = TMP_ALLOC(n2*sizeof(mp_limb_t));
+    for (i = 0; i < n2; i++)
+        b[i] = depth;
+
+    if (((unsigned long) a % 16) != 0 || ((unsigned long) b % 16) != 0)
+    {
+        printf("FAIL:\n");
+        printf("unaligned block at depth %ld\n", depth);
+        abort();
+    }
+
+    nested_alloc(state, depth - 1);
+
+    for (i = 0; i < n1; i++)
+    {
+        if (a[i] != depth + i)
+        {
+            printf("FAIL:\n");
+            printf("block overwritten at depth %ld\n", depth);
+            abort();
+        }
+    }
+
+    for (i = 0; i < n2; i++)
+    {
+        if (b[i] != depth)
+        {
+            printf("FAIL:\n");
+            printf("block overwritten at depth %ld\n", depth);
+            abort();
+        }
+    }
+
+    TMP_END;
+}
+
+int main(void)
+{
+    int i;
+    void * p;
+    flint_rand_t state;
+
+    printf("tmp_alloc....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 100 * flint_test_multiplier(); i++)
+        nested_alloc(state, n_randint(state, 6));
+
+    /* Check the memory functions can be replaced and reset */
+    flint_tmp_cleanup();
+    flint_set_memory_functions(counting_malloc, NULL, NULL, NULL);
+
+    p = flint_malloc(100);
+    flint_free(p);
+    nested_alloc(state, 3);
+
+    flint_set_memory_functions(NULL, NULL, NULL, NULL);
+
+    if (num_allocs < 2)
+    {
+        printf("FAIL:\n");
+        printf("custom allocator not used, num_allocs = %ld\n", num_allocs);
+        abort();
+    }
+
+    num_allocs = 0;
+    p = flint_malloc(100);
+    flint_free(p);
+
+    if (num_allocs != 0)
+    {
+        printf("FAIL:\n");
+        printf("default allocator not restored\n");
+        abort();
+    }
+
+    flint_tmp_cleanup();
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,410 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#undef ulong /* interferes with system includes */
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#define ulong unsigned long
+#include "flint.h"
+#include "thread_pool.h"
+
+int global_thread_pool_initialized = 0;
+
+thread_pool_t global_thread_pool;
+
+/*
+   Each worker sleeps on its own condition variable until it is given some 
+   work by thread_pool_wake, or is told to exit.
+*/
+static void * _thread_pool_idle_loop(void * varg)
+{
+    thread_pool_entry_struct * D = (thread_pool_entry_struct *) varg;
+
+    pthread_mutex_lock(&D->mutex);
+
+    while (1)
+    {
+        while (!D->working && !D->exit)
+            pthread_cond_wait(&D->sleep1, &D->mutex);
+
+        if (D->exit)
+            break;
+
+        pthread_mutex_unlock(&D->mutex);
+
+        D->fxn(D->fxnarg);
+
+        pthread_mutex_lock(&D->mutex);
+        D->working = 0;
+        pthread_cond_signal(&D->sleep2);
+    }
+
+    pthread_mutex_unlock(&D->mutex);
+
+    return NULL;
+}
+
+static void _thread_pool_entry_init(thread_pool_entry_struct * D)
+{
+    pthread_mutex_init(&D->mutex, NULL);
+    pthread_cond_init(&D->sleep1, NULL);
+    pthread_cond_init(&D->sleep2, NULL);
+    D->available = 1;
+    D->working = 0;
+    D->exit = 0;
+    D->fxn = NULL;
+    D->fxnarg = NULL;
+
+    pthread_create(&D->pth, NULL, _thread_pool_idle_loop, D);
+}
+
+static void _thread_pool_entry_clear(thread_pool_entry_struct * D)
+{
+    pthread_mutex_lock(&D->mutex);
+    D->exit = 1;
+    pthread_cond_signal(&D->sleep1);
+    pthread_mutex_unlock(&D->mutex);
+
+    pthread_join(D->pth, NULL);
+
+    pthread_cond_destroy(&D->sleep2);
+    pthread_cond_destroy(&D->sleep1);
+    pthread_mutex_destroy(&D->mutex);
+}
+
+void thread_pool_init(thread_pool_t T, long size)
+{
+    long i;
+
+    pthread_mutex_init(&T->mutex, NULL);
+
+    size = FLINT_MAX(size, 0L);
+    T->length = size;
+    T->tdata = NULL;
+
+    if (size > 0)
+    {
+        T->tdata = flint_malloc(size*sizeof(thread_pool_entry_struct));
+        for (i = 0; i < size; i++)
+            _thread_pool_entry_init(T->tdata + i);
+    }
+}
+
+long thread_pool_get_size(thread_pool_t T)
+{
+    long size;
+
+    pthread_mutex_lock(&T->mutex);
+    size = T->length;
+    pthread_mutex_unlock(&T->mutex);
+
+    return size;
+}
+
+int thread_pool_set_size(thread_pool_t T, long new_size)
+{
+    long i;
+
+    new_size = FLINT_MAX(new_size, 0L);
+
+    pthread_mutex_lock(&T->mutex);
+
+    /* the pool can only be resized when none of its threads are in use */
+    for (i = 0; i < T->length; i++)
+    {
+        if (!T->tdata[i].available)
+        {
+            pthread_mutex_unlock(&T->mutex);
+            return 0;
+        }
+    }
+
+    for (i = 0; i < T->length; i++)
+        _thread_pool_entry_clear(T->tdata + i);
+
+    if (T->tdata != NULL)
+        flint_free(T->tdata);
+
+    T->length = new_size;
+    T->tdata = NULL;
+
+    if (new_size > 0)
+    {
+        T->tdata = flint_malloc(new_size*sizeof(thread_pool_entry_struct));
+        for (i = 0; i < new_size; i++)
+            _thread_pool_entry_init(T->tdata + i);
+    }
+
+    pthread_mutex_unlock(&T->mutex);
+
+    return 1;
+}
+
+long thread_pool_request(thread_pool_t T, thread_pool_handle * out, 
+                                                                long requested)
+{
+    long i, num = 0;
+
+    if (requested <= 0)
+        return 0;
+
+    pthread_mutex_lock(&T->mutex);
+
+    for (i = 0; i < T->length && num < requested; i++)
+    {
+        if (T->tdata[i].available)
+        {
+            T->tdata[i].available = 0;
+            out[num++] = i;
+        }
+    }
+
+    pthread_mutex_unlock(&T->mutex);
+
+    return num;
+}
+
+void thread_pool_wake(thread_pool_t T, thread_pool_handle i, 
+                                                   void (* f)(void *), void * a)
+{
+    thread_pool_entry_struct * D = T->tdata + i;
+
+    pthread_mutex_lock(&D->mutex);
+    D->fxn = f;
+    D->fxnarg = a;
+    D->working = 1;
+    pthread_cond_signal(&D->sleep1);
+    pthread_mutex_unlock(&D->mutex);
+}
+
+void thread_pool_wait(thread_pool_t T, thread_pool_handle i)
+{
+    thread_pool_entry_struct * D = T->tdata + i;
+
+    pthread_mutex_lock(&D->mutex);
+    while (D->working)
+        pthread_cond_wait(&D->sleep2, &D->mutex);
+    pthread_mutex_unlock(&D->mutex);
+}
+
+void thread_pool_give_back(thread_pool_t T, thread_pool_handle i)
+{
+    pthread_mutex_lock(&T->mutex);
+    T->tdata[i].available = 1;
+    pthread_mutex_unlock(&T->mutex);
+}
+
+void thread_pool_clear(thread_pool_t T)
+{
+    long i;
+
+    for (i = 0; i < T->length; i++)
+        _thread_pool_entry_clear(T->tdata + i);
+
+    if (T->tdata != NULL)
+        flint_free(T->tdata);
+
+    T->tdata = NULL;
+    T->length = 0;
+
+    pthread_mutex_destroy(&T->mutex);
+}
+
+long flint_request_threads(thread_pool_handle ** handles, long thread_limit)
+{
+    long num = FLINT_MIN(thread_limit, flint_get_num_threads()) - 1;
+
+    *handles = NULL;
+
+    if (!global_thread_pool_initialized || num <= 0)
+        return 0;
+
+    *handles = flint_malloc(num*sizeof(thread_pool_handle));
+    num = thread_pool_request(global_thread_pool, *handles, num);
+
+    if (num == 0)
+    {
+        flint_free(*handles);
+        *handles = NULL;
+    }
+
+    return num;
+}
+
+void flint_give_back_threads(thread_pool_handle * handles, long num_handles)
+{
+    long i;
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_give_back(global_thread_pool, handles[i]);
+
+    if (handles != NULL)
+        flint_free(handles);
+}
+
+/*
+   flint_parallel_do: each participating thread starts with a contiguous 
+   block of the indices. When a thread runs out of work it steals the top 
+   half of the largest remaining block of another thread.
+*/
+
+typedef struct
+{
+    long start;
+    long end;
+    pthread_mutex_t mutex;
+} _parallel_range_struct;
+
+typedef struct
+{
+    void (* f)(void *, long);
+    void * args;
+    _parallel_range_struct * ranges;
+    long num;
+    long self;
+} _parallel_do_arg_struct;
+
+static int _parallel_steal(_parallel_do_arg_struct * arg)
+{
+    _parallel_range_struct * R = arg->ranges;
+    long k, victim = -1, best = 0, start = 0, end = 0;
+
+    /* unlocked reads are only used to select a victim */
+    for (k = 0; k < arg->num; k++)
+    {
+        long rem = R[k].end - R[k].start;
+
+        if (k != arg->self && rem > best)
+        {
+            best = rem;
+            victim = k;
+        }
+    }
+
+    if (victim == -1)
+        return 0;
+
+    pthread_mutex_lock(&R[victim].mutex);
+    if (R[victim].end > R[victim].start)
+    {
+        end = R[victim].end;
+        start = R[victim].start + (R[victim].end - R[victim].start)/2;
+        R[victim].end = start;
+    }
+    pthread_mutex_unlock(&R[victim].mutex);
+
+    if (start == end)
+        return 1; /* raced with the victim, look again */
+
+    pthread_mutex_lock(&R[arg->self].mutex);
+    R[arg->self].start = start;
+    R[arg->self].end = end;
+    pthread_mutex_unlock(&R[arg->self].mutex);
+
+    return 1;
+}
+
+static void _parallel_do_worker(void * varg)
+{
+    _parallel_do_arg_struct * arg = (_parallel_do_arg_struct *) varg;
+    _parallel_range_struct * r = arg->ranges + arg->self;
+    long i;
+
+    while (1)
+    {
+        pthread_mutex_lock(&r->mutex);
+        if (r->start < r->end)
+        {
+            i = r->start++;
+            pthread_mutex_unlock(&r->mutex);
+
+            arg->f(arg->args, i);
+        } else
+        {
+            pthread_mutex_unlock(&r->mutex);
+
+            if (!_parallel_steal(arg))
+                return;
+        }
+    }
+}
+
+void flint_parallel_do(void (* f)(void *, long), void * args, 
+                                                      long n, long thread_limit)
+{
+    thread_pool_handle * handles;
+    _parallel_range_struct * ranges;
+    _parallel_do_arg_struct * pargs;
+    long i, num_workers, num;
+
+    if (n <= 0)
+        return;
+
+    num_workers = flint_request_threads(&handles, FLINT_MIN(thread_limit, n));
+
+    if (num_workers == 0)
+    {
+        for (i = 0; i < n; i++)
+            f(args, i);
+
+        return;
+    }
+
+    num = num_workers + 1;
+
+    ranges = flint_malloc(num*sizeof(_parallel_range_struct));
+    pargs = flint_malloc(num*sizeof(_parallel_do_arg_struct));
+
+    for (i = 0; i < num; i++)
+    {
+        ranges[i].start = (i*n)/num;
+        ranges[i].end = ((i + 1)*n)/num;
+        pthread_mutex_init(&ranges[i].mutex, NULL);
+
+        pargs[i].f = f;
+        pargs[i].args = args;
+        pargs[i].ranges = ranges;
+        pargs[i].num = num;
+        pargs[i].self = i;
+    }
+
+    for (i = 0; i < num_workers; i++)
+        thread_pool_wake(global_thread_pool, handles[i], 
+                                       _parallel_do_worker, pargs + i + 1);
+
+    _parallel_do_worker(pargs);
+
+    for (i = 0; i < num_workers; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
+
+    flint_give_back_threads(handles, num_workers);
+
+    for (i = 0; i < num; i++)
+        pthread_mutex_destroy(&ranges[i].mutex);
+
+    flint_free(pargs);
+    flint_free(ranges);
+}
@@ -0,0 +1,103 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#undef ulong /* interferes with system includes */
+#include <pthread.h>
+#define ulong unsigned long
+
+#include "flint.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+typedef struct
+{
+    pthread_t pth;
+    pthread_mutex_t mutex;
+    pthread_cond_t sleep1;
+    pthread_cond_t sleep2;
+    volatile int available;
+    volatile int working;
+    volatile int exit;
+    void (* fxn)(void *);
+    void * fxnarg;
+} thread_pool_entry_struct;
+
+typedef thread_pool_entry_struct thread_pool_entry_t[1];
+
+typedef struct
+{
+    thread_pool_entry_struct * tdata;
+    long length;
+    pthread_mutex_t mutex;
+} thread_pool_struct;
+
+typedef thread_pool_struct thread_pool_t[1];
+
+typedef long thread_pool_handle;
+
+extern int global_thread_pool_initialized;
+
+extern thread_pool_t global_thread_pool;
+
+/* Low level interface *******************************************************/
+
+void thread_pool_init(thread_pool_t T, long size);
+
+long thread_pool_get_size(thread_pool_t T);
+
+int thread_pool_set_size(thread_pool_t T, long new_size);
+
+long thread_pool_request(thread_pool_t T, thread_pool_handle * out, 
+                                                               long requested);
+
+void thread_pool_wake(thread_pool_t T, thread_pool_handle i, 
+                                                  void (* f)(void *), void * a);
+
+void thread_pool_wait(thread_pool_t T, thread_pool_handle i);
+
+void thread_pool_give_back(thread_pool_t T, thread_pool_handle i);
+
+void thread_pool_clear(thread_pool_t T);
+
+/* High level interface ******************************************************/
+
+long flint_request_threads(thread_pool_handle ** handles, long thread_limit);
+
+void flint_give_back_threads(thread_pool_handle * handles, long num_handles);
+
+void flint_parallel_do(void (* f)(void *, long), void * args, 
+                                                     long n, long thread_limit);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
@@ -0,0 +1,58 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 FLINT authors
+
+******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "flint.h"
+#include "thread_pool.h"
+
+int _flint_num_threads = 1;
+
+int flint_get_num_threads(void)
+{
+    return _flint_num_threads;
+}
+
+void flint_set_num_threads(int num_threads)
+{
+    if (num_threads < 1)
+    {
+        printf("Exception (flint_set_num_threads). Number of threads must be positive.\n");
+        abort();
+    }
+
+    /* all but the calling thread are taken from the global pool */
+    if (!global_thread_pool_initialized)
+    {
+        if (num_threads > 1)
+        {
+            thread_pool_init(global_thread_pool, num_threads - 1);
+            global_thread_pool_initialized = 1;
+        }
+    } else
+        thread_pool_set_size(global_thread_pool, num_threads - 1);
+
+    _flint_num_threads = num_threads;
+}